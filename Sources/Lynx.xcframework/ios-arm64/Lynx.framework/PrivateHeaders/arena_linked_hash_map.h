@@ -0,0 +1,287 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_ARENA_LINKED_HASH_MAP_H_
+#define BASE_INCLUDE_ARENA_LINKED_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "base/include/boost/unordered.h"
+#include "base/include/fml/macros.h"
+#include "base/include/monotonic_arena.h"
+
+namespace lynx {
+namespace base {
+
+/**
+ ArenaLinkedHashMap is an insertion ordered map with the LinkedHashMap
+ interface subset used by temporaries of a single pass, e.g. the StyleMaps
+ built during one style resolve, whose nodes come from a MonotonicArena.
+
+ A node costs a bump of the arena cursor; erased nodes are recycled through a
+ free list and nothing is returned to the arena, which drops everything at
+ once with MonotonicArena::Reset(). Values are destroyed with the map. The
+ hash index built above FindBuildMapThreshold still lives on the heap.
+
+ It is a distinct type from LinkedHashMap so that heap backed maps keep their
+ layout, and it can be neither copied nor moved: it lives in the scope of the
+ arena. Results that must outlive the pass are copied into a heap backed map
+ with CopyTo() or MoveTo().
+
+ Not thread safe.
+ */
+template <class Key, class T,
+          uint32_t FindBuildMapThreshold =
+              (std::is_integral_v<Key> || std::is_enum_v<Key>) ? 12 : 6,
+          class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+class ArenaLinkedHashMap {
+ public:
+  using size_type = size_t;
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+
+ private:
+  struct Link {
+    Link* prev;
+    Link* next;
+  };
+
+  struct Node : Link {
+    template <class... Args>
+    explicit Node(Args&&... args)
+        : Link{nullptr, nullptr}, value(std::forward<Args>(args)...) {}
+
+    value_type value;
+  };
+
+  template <bool Const>
+  class IteratorBase {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = ArenaLinkedHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const value_type&, value_type&>;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+    IteratorBase() = default;
+    explicit IteratorBase(Link* link) : link_(link) {}
+    // Allows converting iterator to const_iterator.
+    IteratorBase(const IteratorBase<false>& other) : link_(other.link_) {}
+
+    reference operator*() const { return static_cast<Node*>(link_)->value; }
+    pointer operator->() const { return &static_cast<Node*>(link_)->value; }
+
+    IteratorBase& operator++() {
+      link_ = link_->next;
+      return *this;
+    }
+    IteratorBase operator++(int) {
+      IteratorBase t(*this);
+      ++(*this);
+      return t;
+    }
+    IteratorBase& operator--() {
+      link_ = link_->prev;
+      return *this;
+    }
+    IteratorBase operator--(int) {
+      IteratorBase t(*this);
+      --(*this);
+      return t;
+    }
+
+    friend bool operator==(const IteratorBase& x, const IteratorBase& y) {
+      return x.link_ == y.link_;
+    }
+    friend bool operator!=(const IteratorBase& x, const IteratorBase& y) {
+      return x.link_ != y.link_;
+    }
+
+   private:
+    friend class ArenaLinkedHashMap;
+    Link* link_{nullptr};
+  };
+
+ public:
+  using iterator = IteratorBase<false>;
+  using const_iterator = IteratorBase<true>;
+
+  /// @param arena Arena providing node memory, must outlive the map.
+  explicit ArenaLinkedHashMap(MonotonicArena& arena) : arena_(arena) {}
+
+  ~ArenaLinkedHashMap() { clear(); }
+
+  iterator begin() { return iterator(head_.next); }
+  iterator end() { return iterator(&head_); }
+  const_iterator begin() const { return const_iterator(head_.next); }
+  const_iterator end() const { return const_iterator(Sentinel()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return count_ == 0; }
+  size_type size() const { return count_; }
+
+  MonotonicArena& arena() const { return arena_; }
+
+  iterator find(const Key& key) { return iterator(FindLink(key)); }
+
+  const_iterator find(const Key& key) const {
+    return const_iterator(
+        const_cast<ArenaLinkedHashMap*>(this)->FindLink(key));
+  }
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    if (Link* link = FindLink(key); link != &head_) {
+      return {iterator(link), false};
+    }
+    return {iterator(NewNode(std::piecewise_construct,
+                             std::forward_as_tuple(key),
+                             std::forward_as_tuple(
+                                 std::forward<Args>(args)...))),
+            true};
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    if (Link* link = FindLink(key); link != &head_) {
+      static_cast<Node*>(link)->value.second = std::forward<M>(obj);
+      return {iterator(link), false};
+    }
+    return {iterator(NewNode(key, std::forward<M>(obj))), true};
+  }
+
+  size_type erase(const Key& key) {
+    Link* link = FindLink(key);
+    if (link == &head_) {
+      return 0;
+    }
+    EraseLink(link);
+    return 1;
+  }
+
+  iterator erase(const_iterator pos) {
+    Link* next = pos.link_->next;
+    EraseLink(pos.link_);
+    return iterator(next);
+  }
+
+  /// Destroys all values. The nodes are kept for the following insertions.
+  void clear() {
+    Link* link = head_.next;
+    while (link != &head_) {
+      Link* next = link->next;
+      ReleaseNode(static_cast<Node*>(link));
+      link = next;
+    }
+    head_.prev = head_.next = &head_;
+    count_ = 0;
+    map_.reset();
+  }
+
+  /// Inserts or assigns every entry, in order, into |out|, typically a heap
+  /// backed LinkedHashMap that outlives the arena.
+  template <class Map>
+  void CopyTo(Map& out) const {
+    for (const auto& [key, value] : *this) {
+      out.insert_or_assign(key, value);
+    }
+  }
+
+  template <class Map>
+  void MoveTo(Map& out) {
+    for (auto& [key, value] : *this) {
+      out.insert_or_assign(key, std::move(value));
+    }
+    clear();
+  }
+
+ private:
+  using map_type = boost::unordered_flat_map<Key, Link*, Hash, Pred>;
+
+  Link* Sentinel() const { return const_cast<Link*>(&head_); }
+
+  Link* FindLink(const Key& key) {
+    if (map_ != nullptr) {
+      auto it = map_->find(key);
+      return it != map_->end() ? it->second : &head_;
+    }
+    for (Link* link = head_.next; link != &head_; link = link->next) {
+      if (pred_(static_cast<Node*>(link)->value.first, key)) {
+        return link;
+      }
+    }
+    return &head_;
+  }
+
+  template <class... Args>
+  Link* NewNode(Args&&... args) {
+    void* memory = free_list_;
+    if (memory != nullptr) {
+      free_list_ = free_list_->next;
+    } else {
+      memory = arena_.Allocate(sizeof(Node), alignof(Node));
+    }
+    Node* node = new (memory) Node(std::forward<Args>(args)...);
+    node->prev = head_.prev;
+    node->next = &head_;
+    head_.prev->next = node;
+    head_.prev = node;
+    ++count_;
+    if (map_ != nullptr) {
+      map_->emplace(node->value.first, node);
+    } else if (count_ >= FindBuildMapThreshold) {
+      map_ = std::make_unique<map_type>();
+      map_->reserve(count_);
+      for (Link* link = head_.next; link != &head_; link = link->next) {
+        map_->emplace(static_cast<Node*>(link)->value.first, link);
+      }
+    }
+    return node;
+  }
+
+  void EraseLink(Link* link) {
+    if (map_ != nullptr) {
+      map_->erase(static_cast<Node*>(link)->value.first);
+    }
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    --count_;
+    ReleaseNode(static_cast<Node*>(link));
+  }
+
+  void ReleaseNode(Node* node) {
+    node->~Node();
+    free_list_ = new (static_cast<void*>(node)) Link{nullptr, free_list_};
+  }
+
+  MonotonicArena& arena_;
+  // Sentinel of the circular list, in insertion order.
+  Link head_{&head_, &head_};
+  // Recycled node memory, linked through Link::next.
+  Link* free_list_{nullptr};
+  size_type count_{0};
+  std::unique_ptr<map_type> map_;
+  Pred pred_;
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(ArenaLinkedHashMap);
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_ARENA_LINKED_HASH_MAP_H_
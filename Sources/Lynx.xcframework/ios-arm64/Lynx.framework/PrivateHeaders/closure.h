@@ -10,9 +10,11 @@
 
 #include <cstddef>
 #include <functional>
+#include <new>
 #include <type_traits>
 #include <utility>
 
+#include "base/include/closure_allocator.h"
 #include "base/include/fml/macros.h"
 
 namespace lynx {
@@ -118,6 +120,174 @@ class MoveOnlyClosure {
 
 using closure = base::MoveOnlyClosure<>;
 
+/**
+ InlineMoveOnlyClosure has the same interface as MoveOnlyClosure but stores
+ callables of up to InlineSize bytes in place instead of on the heap, so that
+ posting a task capturing a few pointers or a shared_ptr does not allocate.
+ Larger callables, or ones that cannot be moved without throwing, overflow to
+ ClosureAllocator which recycles blocks through per thread free lists.
+
+ The type is erased through a static table of function pointers rather than a
+ virtual ClosureImpl, so an inline callable costs no extra indirection.
+
+ It is a distinct, opt-in type: base::closure stays MoveOnlyClosure<> since it
+ is part of the signatures compiled into the Lynx binary, e.g.
+ TaskRunner::PostTask(). Use it for queues owned by a single component.
+ */
+template <size_t InlineSize, typename Ret = void, typename... Args>
+class InlineMoveOnlyClosure {
+ public:
+  static constexpr size_t kInlineSize = InlineSize;
+
+  InlineMoveOnlyClosure() = default;
+  InlineMoveOnlyClosure(std::nullptr_t) {}
+
+  template <typename F,
+            typename = std::enable_if_t<
+                std::is_invocable_r_v<Ret, F, Args...> &&
+                !std::is_same_v<std::decay_t<F>, InlineMoveOnlyClosure>>>
+  InlineMoveOnlyClosure(F&& func) {
+    using Func = std::decay_t<F>;
+    if constexpr (IsStoredInline<Func>()) {
+      new (storage_) Func(std::move(func));
+      ClosureAllocator::RecordInline();
+    } else if constexpr (IsPooled<Func>()) {
+      void* block = ClosureAllocator::Allocate(sizeof(Func));
+      new (block) Func(std::move(func));
+      *reinterpret_cast<void**>(storage_) = block;
+    } else {
+      *reinterpret_cast<Func**>(storage_) = new Func(std::move(func));
+    }
+    ops_ = &kOps<Func>;
+  }
+
+  ~InlineMoveOnlyClosure() { Reset(); }
+
+  // Deleted for the same reason as MoveOnlyClosure(F&).
+  template <typename F>
+  InlineMoveOnlyClosure(F&) = delete;
+  InlineMoveOnlyClosure(const InlineMoveOnlyClosure&) = delete;
+  InlineMoveOnlyClosure& operator=(const InlineMoveOnlyClosure&) = delete;
+
+  InlineMoveOnlyClosure(InlineMoveOnlyClosure&& other) noexcept {
+    MoveFrom(other);
+  }
+
+  InlineMoveOnlyClosure& operator=(InlineMoveOnlyClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  InlineMoveOnlyClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  Ret operator()(Args... arguments) const {
+    return ops_->invoke(storage_, std::forward<Args>(arguments)...);
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  bool operator==(std::nullptr_t) const { return ops_ == nullptr; }
+
+  bool operator!=(std::nullptr_t) const { return ops_ != nullptr; }
+
+ private:
+  static constexpr size_t kStorageSize =
+      InlineSize < sizeof(void*) ? sizeof(void*) : InlineSize;
+
+  struct Ops {
+    Ret (*invoke)(void* storage, Args&&... arguments);
+    // Move constructs |dst| from |src| and destroys |src|.
+    void (*relocate)(void* dst, void* src);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Func>
+  static constexpr bool IsStoredInline() {
+    return sizeof(Func) <= kStorageSize && alignof(Func) <= alignof(void*) &&
+           std::is_nothrow_move_constructible_v<Func>;
+  }
+
+  // Over aligned callables bypass the pool, whose blocks come from malloc.
+  template <typename Func>
+  static constexpr bool IsPooled() {
+    return alignof(Func) <= alignof(std::max_align_t);
+  }
+
+  template <typename Func>
+  static Func* Target(void* storage) {
+    if constexpr (IsStoredInline<Func>()) {
+      return static_cast<Func*>(storage);
+    } else {
+      return *static_cast<Func**>(storage);
+    }
+  }
+
+  template <typename Func>
+  static Ret Invoke(void* storage, Args&&... arguments) {
+    return (*Target<Func>(storage))(std::forward<Args>(arguments)...);
+  }
+
+  template <typename Func>
+  static void Relocate(void* dst, void* src) {
+    if constexpr (IsStoredInline<Func>()) {
+      Func* func = static_cast<Func*>(src);
+      new (dst) Func(std::move(*func));
+      func->~Func();
+    } else {
+      *static_cast<void**>(dst) = *static_cast<void**>(src);
+    }
+  }
+
+  template <typename Func>
+  static void Destroy(void* storage) {
+    Func* func = Target<Func>(storage);
+    if constexpr (IsStoredInline<Func>()) {
+      func->~Func();
+    } else if constexpr (IsPooled<Func>()) {
+      func->~Func();
+      ClosureAllocator::Deallocate(func, sizeof(Func));
+    } else {
+      delete func;
+    }
+  }
+
+  template <typename Func>
+  static constexpr Ops kOps = {&Invoke<Func>, &Relocate<Func>,
+                               &Destroy<Func>};
+
+  void MoveFrom(InlineMoveOnlyClosure& other) {
+    if (other.ops_ != nullptr) {
+      other.ops_->relocate(storage_, other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      // Cleared first in case the callable owns the last reference to self.
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(storage_);
+    }
+  }
+
+  alignas(void*) mutable unsigned char storage_[kStorageSize];
+  const Ops* ops_ = nullptr;
+};
+
+// Inline storage of inline_closure in bytes. Fixed, so that every
+// translation unit agrees on the layout.
+inline constexpr size_t kInlineClosureSize = 48;
+
+using inline_closure = base::InlineMoveOnlyClosure<kInlineClosureSize>;
+
 }  // namespace base
 }  // namespace lynx
 
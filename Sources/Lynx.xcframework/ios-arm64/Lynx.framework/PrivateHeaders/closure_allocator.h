@@ -0,0 +1,194 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_CLOSURE_ALLOCATOR_H_
+#define BASE_INCLUDE_CLOSURE_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace lynx {
+namespace base {
+
+struct ClosureAllocationStats {
+  // Closures whose callable was stored inline.
+  uint64_t inline_count = 0;
+  // Closures whose callable overflowed the inline storage.
+  uint64_t overflow_count = 0;
+  // Overflows that had to call malloc, i.e. missed the pool.
+  uint64_t malloc_count = 0;
+};
+
+/**
+ ClosureAllocator serves the overflow path of InlineMoveOnlyClosure, i.e.
+ callables too large for the inline storage.
+
+ Blocks are rounded up to a few size classes and recycled through per thread
+ free lists, so a steady stream of posted tasks stops calling malloc once the
+ lists are warm. A block freed on another thread than the one which allocated
+ it simply joins the free list of the freeing thread. Each list is bounded so
+ that a consumer thread does not hoard memory; surplus blocks and blocks
+ larger than the biggest class go straight back to the system.
+ */
+class ClosureAllocator {
+ public:
+  static constexpr size_t kSizeClassCount = 3;
+  static constexpr size_t kMaxPooledSize = 256;
+  static constexpr size_t kMaxCachedBlocks = 128;
+
+  static void* Allocate(size_t size) {
+    RecordOverflow();
+    const size_t size_class = SizeClassOf(size);
+    if (size_class < kSizeClassCount) {
+      Cache& cache = LocalCache();
+      if (FreeBlock* block = cache.heads[size_class]) {
+        cache.heads[size_class] = block->next;
+        --cache.counts[size_class];
+        return block;
+      }
+      size = SizeOfClass(size_class);
+    }
+    RecordMalloc();
+    void* ptr = std::malloc(size);
+    if (ptr == nullptr) {
+      // Base is built without exceptions.
+      abort();
+    }
+    return ptr;
+  }
+
+  // |size| must be the one passed to Allocate().
+  static void Deallocate(void* ptr, size_t size) {
+    const size_t size_class = SizeClassOf(size);
+    if (size_class < kSizeClassCount) {
+      Cache& cache = LocalCache();
+      if (!cache.dead && cache.counts[size_class] < kMaxCachedBlocks) {
+        if (!cache.reaper_registered) {
+          // Registers the flush on thread exit.
+          static thread_local CacheReaper reaper;
+          (void)reaper;
+          cache.reaper_registered = true;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = cache.heads[size_class];
+        cache.heads[size_class] = block;
+        ++cache.counts[size_class];
+        return;
+      }
+    }
+    std::free(ptr);
+  }
+
+  static void RecordInline() {
+    if (IsStatsEnabled()) {
+      Counters().inline_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Counting is off by default. A runtime switch rather than a macro, so that
+  // every translation unit shares the same inline definitions.
+  static void SetStatsEnabled(bool enabled) {
+    StatsEnabled().store(enabled, std::memory_order_relaxed);
+  }
+
+  // All zero unless enabled with SetStatsEnabled().
+  static ClosureAllocationStats GetStats() {
+    ClosureAllocationStats stats;
+    auto& counters = Counters();
+    stats.inline_count = counters.inline_count.load(std::memory_order_relaxed);
+    stats.overflow_count =
+        counters.overflow_count.load(std::memory_order_relaxed);
+    stats.malloc_count = counters.malloc_count.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  static void ResetStats() {
+    auto& counters = Counters();
+    counters.inline_count.store(0, std::memory_order_relaxed);
+    counters.overflow_count.store(0, std::memory_order_relaxed);
+    counters.malloc_count.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Trivially destructible so that it stays usable while other thread locals,
+  // e.g. a message loop holding pending tasks, are destroyed on thread exit.
+  struct Cache {
+    FreeBlock* heads[kSizeClassCount];
+    uint32_t counts[kSizeClassCount];
+    bool reaper_registered;
+    bool dead;
+  };
+
+  struct CacheReaper {
+    ~CacheReaper() {
+      Cache& cache = LocalCache();
+      for (size_t i = 0; i < kSizeClassCount; ++i) {
+        while (FreeBlock* block = cache.heads[i]) {
+          cache.heads[i] = block->next;
+          std::free(block);
+        }
+        cache.counts[i] = 0;
+      }
+      cache.dead = true;
+    }
+  };
+
+  static Cache& LocalCache() {
+    static thread_local Cache cache{};
+    return cache;
+  }
+
+  // 64, 128, 256.
+  static size_t SizeClassOf(size_t size) {
+    return size <= 64 ? 0 : size <= 128 ? 1 : size <= kMaxPooledSize ? 2
+                                                    : kSizeClassCount;
+  }
+
+  static size_t SizeOfClass(size_t size_class) {
+    return size_t(64) << size_class;
+  }
+
+  struct AtomicStats {
+    std::atomic<uint64_t> inline_count{0};
+    std::atomic<uint64_t> overflow_count{0};
+    std::atomic<uint64_t> malloc_count{0};
+  };
+
+  static AtomicStats& Counters() {
+    static AtomicStats counters;
+    return counters;
+  }
+
+  static std::atomic_bool& StatsEnabled() {
+    static std::atomic_bool enabled{false};
+    return enabled;
+  }
+
+  static bool IsStatsEnabled() {
+    return StatsEnabled().load(std::memory_order_relaxed);
+  }
+
+  static void RecordOverflow() {
+    if (IsStatsEnabled()) {
+      Counters().overflow_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  static void RecordMalloc() {
+    if (IsStatsEnabled()) {
+      Counters().malloc_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_CLOSURE_ALLOCATOR_H_
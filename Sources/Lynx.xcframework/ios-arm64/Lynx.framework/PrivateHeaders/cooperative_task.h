@@ -0,0 +1,172 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_BASE_THREADING_COOPERATIVE_TASK_H_
+#define CORE_BASE_THREADING_COOPERATIVE_TASK_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "base/include/closure.h"
+#include "base/include/fml/macros.h"
+#include "base/include/fml/task_runner.h"
+#include "base/include/fml/time/time_delta.h"
+#include "base/include/fml/time/time_point.h"
+
+namespace lynx {
+namespace base {
+
+/**
+ * Time budget of one slice of a CooperativeTask. Long loops, e.g. over the
+ * pending patches of ElementManager or the elements of a template, call
+ * ShouldYield() once per item and stop at the first true.
+ */
+class YieldDeadline {
+ public:
+  static constexpr uint32_t kDefaultCheckInterval = 8;
+
+  explicit YieldDeadline(fml::TimePoint deadline,
+                         uint32_t check_interval = kDefaultCheckInterval)
+      : deadline_(deadline),
+        check_interval_(check_interval == 0 ? 1 : check_interval) {}
+
+  static YieldDeadline After(fml::TimeDelta budget) {
+    return YieldDeadline(fml::TimePoint::Now() + budget);
+  }
+
+  // Never expires, for callers which must finish synchronously.
+  static YieldDeadline Never() { return YieldDeadline(fml::TimePoint::Max()); }
+
+  // Only reads the clock every |check_interval| calls. Stays true once the
+  // deadline has passed.
+  bool ShouldYield() {
+    if (expired_) {
+      return true;
+    }
+    if (++calls_ < check_interval_) {
+      return false;
+    }
+    calls_ = 0;
+    expired_ = fml::TimePoint::Now() >= deadline_;
+    return expired_;
+  }
+
+  bool IsExpired() const { return expired_; }
+
+  fml::TimePoint deadline() const { return deadline_; }
+
+ private:
+  fml::TimePoint deadline_;
+  uint32_t check_interval_;
+  uint32_t calls_{0};
+  bool expired_{false};
+};
+
+/**
+ * Splits a long pipeline running on the TASM thread into slices so that input
+ * and vsync tasks do not stall behind it.
+ *
+ * The step is called with the deadline of the current slice and returns
+ * kYield to be called again in a later task, or kDone. Continuations are
+ * posted with PostTask, i.e. as ordinary tasks, so the vsync and input tasks
+ * queued meanwhile, whichever grade they were posted with, run before the
+ * next slice. Other ordinary tasks posted meanwhile run before it as well, so
+ * the step must not assume the state it works on is untouched between slices.
+ *
+ * The step keeps its own progress and is called on the thread of |runner|.
+ * Each slice is a task of its own, so LongTaskMonitor reports slices instead
+ * of the whole pipeline.
+ *
+ * Run() returns a Handle which the owner of the state the step works on keeps,
+ * e.g. as a member of the ElementManager being flushed. Destroying or
+ * cancelling it drops the remaining slices, so none runs after its owner is
+ * gone.
+ *
+ * Because of the interleaving, only work which nothing reads before it is done
+ * may be sliced, such as the flush of a page in the background or the
+ * instantiation of a template not attached yet. Work that a task queued
+ * meanwhile may depend on, e.g. a flush requested by a sync UI thread call or
+ * one followed by the layout of the same page, must run in one go with
+ * YieldDeadline::Never().
+ */
+class CooperativeTask {
+ public:
+  enum class Status {
+    kDone,
+    kYield,
+  };
+
+  using Step = base::MoveOnlyClosure<Status, YieldDeadline&>;
+
+  static constexpr fml::TimeDelta kDefaultSlice =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  // Cancels the remaining slices when destroyed. Must be destroyed or
+  // cancelled on the thread of the runner.
+  class Handle {
+   public:
+    Handle() = default;
+    Handle(Handle&&) = default;
+    Handle& operator=(Handle&& other) {
+      if (this != &other) {
+        Cancel();
+        cancelled_ = std::move(other.cancelled_);
+      }
+      return *this;
+    }
+    ~Handle() { Cancel(); }
+
+    void Cancel() {
+      if (cancelled_) {
+        *cancelled_ = true;
+        cancelled_.reset();
+      }
+    }
+
+   private:
+    friend class CooperativeTask;
+    explicit Handle(std::shared_ptr<bool> cancelled)
+        : cancelled_(std::move(cancelled)) {}
+
+    std::shared_ptr<bool> cancelled_;
+
+    BASE_DISALLOW_COPY_AND_ASSIGN(Handle);
+  };
+
+  // Runs the first slice synchronously. Must be called on the thread of
+  // |runner|.
+  [[nodiscard]] static Handle Run(fml::RefPtr<fml::TaskRunner> runner,
+                                  Step step,
+                                  fml::TimeDelta slice = kDefaultSlice) {
+    auto cancelled = std::make_shared<bool>(false);
+    RunSlice(std::move(runner), std::move(step), slice, cancelled);
+    return Handle(std::move(cancelled));
+  }
+
+ private:
+  static void RunSlice(fml::RefPtr<fml::TaskRunner> runner, Step step,
+                       fml::TimeDelta slice,
+                       std::shared_ptr<bool> cancelled) {
+    LYNX_BASE_DCHECK(runner->RunsTasksOnCurrentThread());
+    if (*cancelled) {
+      return;
+    }
+    YieldDeadline deadline(fml::TimePoint::Now() + slice);
+    if (step(deadline) == Status::kDone) {
+      return;
+    }
+    fml::TaskRunner* raw_runner = runner.get();
+    raw_runner->PostTask([runner = std::move(runner), step = std::move(step),
+                          slice, cancelled = std::move(cancelled)]() mutable {
+      RunSlice(std::move(runner), std::move(step), slice,
+               std::move(cancelled));
+    });
+  }
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // CORE_BASE_THREADING_COOPERATIVE_TASK_H_
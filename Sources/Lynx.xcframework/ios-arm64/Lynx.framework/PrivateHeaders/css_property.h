@@ -11,6 +11,8 @@
 #include <unordered_map>
 #include <utility>
 
+#include "base/include/arena_linked_hash_map.h"
+#include "base/include/dense_enum_map.h"
 #include "base/include/linked_hash_map.h"
 #include "base/include/no_destructor.h"
 #include "base/include/value/base_string.h"
@@ -186,8 +188,18 @@ using AirParsedStylesMap = std::unordered_map<std::string, AirCompStylesMap>;
 using RawStyleMap = base::LinkedHashMap<CSSPropertyID, tasm::CSSValue>;
 using RawLepusStyleMap = base::LinkedHashMap<CSSPropertyID, lepus::Value>;
 
+// StyleMap for temporaries of one resolve pass, whose nodes come from a
+// base::MonotonicArena owned by the pass. See base::ArenaLinkedHashMap.
+using ArenaStyleMap = base::ArenaLinkedHashMap<CSSPropertyID, tasm::CSSValue>;
+
 constexpr int kCSSPropertyCount = kPropertyEnd;
 
+// Bitset indexed alternative to StyleMap for hot paths that need membership
+// tests, merges and iteration but not insertion order, e.g. merging matched
+// rules by priority. See base::DenseEnumMap.
+using DenseStyleMap =
+    base::DenseEnumMap<CSSPropertyID, tasm::CSSValue, kCSSPropertyCount>;
+
 /* Sometimes, for example, when setting inline styles on nodes one by one
  through the render function, we cannot get the exact number of styles, so we
  provide a fuzzy initial capacity for the StyleMap that stores these styles.
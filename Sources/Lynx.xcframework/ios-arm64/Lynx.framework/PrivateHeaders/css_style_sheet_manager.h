@@ -100,6 +100,7 @@ class CSSStyleSheetManager {
   friend class TemplateBinaryReaderSSR;
   friend class LynxBinaryBaseCSSReader;
   friend class LynxBinaryReader;
+  friend class LynxTemplateBundleCache;
 
   void FlatDependentCSS(SharedCSSFragment* fragment);
 
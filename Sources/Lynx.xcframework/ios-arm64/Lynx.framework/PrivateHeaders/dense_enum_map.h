@@ -0,0 +1,289 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_DENSE_ENUM_MAP_H_
+#define BASE_INCLUDE_DENSE_ENUM_MAP_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base/include/fml/macros.h"
+
+namespace lynx {
+namespace base {
+
+/**
+ DenseEnumMap is a map specialized for keys of a dense enum in [0, KeyCount),
+ such as CSSPropertyID.
+
+ Presence is a bitset of KeyCount bits and values are kept in a compact array
+ sorted by key. The slot of a key is the rank of its bit, i.e. the popcount of
+ the lower bits, so lookups are a bit test plus a few popcounts with no
+ hashing and no probing. Iteration is in key order. Merging two maps is a
+ bitset union followed by a single linear walk over the set bits.
+
+ Insertion order is only tracked after set_track_insertion_order(true), for
+ the few consumers that depend on it (see foreach_in_insertion_order()).
+
+ Unlike LinkedHashMap there is no pointer stability: inserting or erasing may
+ move values.
+ */
+template <class Key, class T, size_t KeyCount>
+class DenseEnumMap {
+  static_assert(std::is_enum_v<Key> || std::is_integral_v<Key>,
+                "DenseEnumMap requires enum or integral keys.");
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = size_t;
+
+  static constexpr size_t kKeyCount = KeyCount;
+
+  DenseEnumMap() = default;
+
+  DenseEnumMap(std::initializer_list<std::pair<Key, T>> initial_list) {
+    values_.reserve(initial_list.size());
+    for (const auto& pair : initial_list) {
+      insert_or_assign(pair.first, pair.second);
+    }
+  }
+
+  DenseEnumMap(const DenseEnumMap&) = default;
+  DenseEnumMap& operator=(const DenseEnumMap&) = default;
+  DenseEnumMap(DenseEnumMap&&) = default;
+  DenseEnumMap& operator=(DenseEnumMap&&) = default;
+
+  bool contains(Key key) const {
+    const size_t index = IndexOf(key);
+    return (bits_[index >> 6] >> (index & 63)) & 1u;
+  }
+
+  T* find(Key key) {
+    return contains(key) ? &values_[Rank(IndexOf(key))] : nullptr;
+  }
+
+  const T* find(Key key) const {
+    return contains(key) ? &values_[Rank(IndexOf(key))] : nullptr;
+  }
+
+  T& operator[](Key key) { return *insert_default_if_absent(key).first; }
+
+  std::pair<T*, bool> insert_default_if_absent(Key key) {
+    const size_t index = IndexOf(key);
+    const size_t slot = Rank(index);
+    if (contains(key)) {
+      return {&values_[slot], false};
+    }
+    return {&*InsertAt(index, slot, T()), true};
+  }
+
+  template <class V>
+  std::pair<T*, bool> insert_or_assign(Key key, V&& value) {
+    const size_t index = IndexOf(key);
+    const size_t slot = Rank(index);
+    if (contains(key)) {
+      values_[slot] = std::forward<V>(value);
+      return {&values_[slot], false};
+    }
+    return {&*InsertAt(index, slot, std::forward<V>(value)), true};
+  }
+
+  template <class V>
+  std::pair<T*, bool> insert_if_absent(Key key, V&& value) {
+    const size_t index = IndexOf(key);
+    const size_t slot = Rank(index);
+    if (contains(key)) {
+      return {&values_[slot], false};
+    }
+    return {&*InsertAt(index, slot, std::forward<V>(value)), true};
+  }
+
+  /// @brief Inserts or assigns from any range of pairs, e.g. a StyleMap.
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert_or_assign(first->first, first->second);
+    }
+  }
+
+  size_type erase(Key key) {
+    if (!contains(key)) {
+      return 0;
+    }
+    const size_t index = IndexOf(key);
+    values_.erase(values_.begin() + Rank(index));
+    bits_[index >> 6] &= ~(uint64_t(1) << (index & 63));
+    if (track_insertion_order_) {
+      order_.erase(std::find(order_.begin(), order_.end(), key));
+    }
+    return 1;
+  }
+
+  void clear() {
+    bits_.fill(0);
+    values_.clear();
+    order_.clear();
+  }
+
+  void reserve(size_type count) { values_.reserve(count); }
+
+  bool empty() const { return values_.empty(); }
+
+  size_type size() const { return values_.size(); }
+
+  /// @brief Starts recording insertion order. Only keys inserted afterwards
+  /// are recorded, so enable it while the map is empty.
+  void set_track_insertion_order(bool track) {
+    track_insertion_order_ = track;
+    if (!track) {
+      order_.clear();
+    }
+  }
+
+  /// @brief Visits entries in key order as callback(key, value).
+  template <typename Callback>
+  void foreach (Callback&& callback) const {
+    size_t slot = 0;
+    ForEachSetBit(bits_, [&](size_t index) {
+      callback(static_cast<Key>(index), values_[slot++]);
+    });
+  }
+
+  template <typename Callback>
+  void foreach (Callback&& callback) {
+    size_t slot = 0;
+    ForEachSetBit(bits_, [&](size_t index) {
+      callback(static_cast<Key>(index), values_[slot++]);
+    });
+  }
+
+  /// @brief Visits entries in insertion order. Falls back to key order when
+  /// insertion order is not tracked.
+  template <typename Callback>
+  void foreach_in_insertion_order(Callback&& callback) const {
+    if (!track_insertion_order_) {
+      foreach (std::forward<Callback>(callback));
+      return;
+    }
+    for (Key key : order_) {
+      callback(key, *find(key));
+    }
+  }
+
+  /// @brief Merges |other| into self. Values of |other| win for keys present
+  /// in both maps, which is the MergeHigherPriorityCSSStyle semantics. Keys
+  /// new to self are appended to the insertion order in key order.
+  void merge(const DenseEnumMap& other) {
+    if (other.empty()) {
+      return;
+    }
+    if (empty() && !track_insertion_order_) {
+      // Only the entries are copied, self keeps its own tracking state.
+      bits_ = other.bits_;
+      values_ = other.values_;
+      return;
+    }
+    std::array<uint64_t, kWordCount> merged_bits;
+    for (size_t i = 0; i < kWordCount; ++i) {
+      merged_bits[i] = bits_[i] | other.bits_[i];
+    }
+    std::vector<T> merged;
+    merged.reserve(Popcount(merged_bits));
+    size_t self_slot = 0;
+    size_t other_slot = 0;
+    ForEachSetBit(merged_bits, [&](size_t index) {
+      const uint64_t mask = uint64_t(1) << (index & 63);
+      const bool in_self = bits_[index >> 6] & mask;
+      const bool in_other = other.bits_[index >> 6] & mask;
+      if (in_other) {
+        merged.push_back(other.values_[other_slot++]);
+        self_slot += in_self;
+      } else {
+        merged.push_back(std::move(values_[self_slot++]));
+      }
+      if (track_insertion_order_ && !in_self) {
+        order_.push_back(static_cast<Key>(index));
+      }
+    });
+    bits_ = merged_bits;
+    values_ = std::move(merged);
+  }
+
+  /// @brief Returns true if any key is present in both maps.
+  bool intersects(const DenseEnumMap& other) const {
+    uint64_t acc = 0;
+    for (size_t i = 0; i < kWordCount; ++i) {
+      acc |= bits_[i] & other.bits_[i];
+    }
+    return acc != 0;
+  }
+
+ private:
+  static constexpr size_t kWordCount = (KeyCount + 63) / 64;
+
+  static size_t IndexOf(Key key) {
+    const size_t index = static_cast<size_t>(key);
+    LYNX_BASE_DCHECK(index < KeyCount);
+    return index;
+  }
+
+  static size_t Popcount(const std::array<uint64_t, kWordCount>& bits) {
+    size_t result = 0;
+    for (uint64_t word : bits) {
+      result += __builtin_popcountll(word);
+    }
+    return result;
+  }
+
+  // Number of present keys below |index|, i.e. the slot of |index|.
+  size_t Rank(size_t index) const {
+    const size_t word = index >> 6;
+    size_t result = 0;
+    for (size_t i = 0; i < word; ++i) {
+      result += __builtin_popcountll(bits_[i]);
+    }
+    const uint64_t below = (uint64_t(1) << (index & 63)) - 1;
+    return result + __builtin_popcountll(bits_[word] & below);
+  }
+
+  template <typename Visitor>
+  static void ForEachSetBit(const std::array<uint64_t, kWordCount>& bits,
+                            Visitor&& visitor) {
+    for (size_t i = 0; i < kWordCount; ++i) {
+      uint64_t word = bits[i];
+      while (word != 0) {
+        visitor((i << 6) + __builtin_ctzll(word));
+        word &= word - 1;
+      }
+    }
+  }
+
+  template <class V>
+  typename std::vector<T>::iterator InsertAt(size_t index, size_t slot,
+                                             V&& value) {
+    bits_[index >> 6] |= uint64_t(1) << (index & 63);
+    if (track_insertion_order_) {
+      order_.push_back(static_cast<Key>(index));
+    }
+    return values_.insert(values_.begin() + slot, std::forward<V>(value));
+  }
+
+  std::array<uint64_t, kWordCount> bits_{};
+  // Sorted by key, values_[Rank(key)] belongs to key.
+  std::vector<T> values_;
+  std::vector<Key> order_;
+  bool track_insertion_order_{false};
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_DENSE_ENUM_MAP_H_
@@ -0,0 +1,611 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_RENDERER_UTILS_BASE_ELEMENT_TEMPLATE_SNAPSHOT_H_
+#define CORE_RENDERER_UTILS_BASE_ELEMENT_TEMPLATE_SNAPSHOT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/renderer/utils/base/element_template_info.h"
+
+namespace lynx {
+namespace tasm {
+
+/**
+ * Snapshot of fully constructed element subtrees as a flat, relocatable blob,
+ * so that a static element template is instantiated without walking the
+ * builtin attributes, id selector, inline styles, classes, events, dataset and
+ * parsed styles sections of each element again.
+ *
+ * The blob only holds offsets relative to its own start, it can be stored in
+ * the template, copied or mapped anywhere. Layout, every integer is a little
+ * endian uint32 and nothing needs to be aligned:
+ *
+ *   header   {magic, version, node_count, root_count, pool_size,
+ *             string_count, string_bytes_size}
+ *   nodes    node_count records of kNodeWords words, in preorder
+ *   pool     pool_size words, the lists referenced by the nodes
+ *   strings  string_count {offset, length} into the string bytes
+ *   bytes    string_bytes_size bytes
+ *
+ * A node covers its subtree: its first child, if any, is the next node, and
+ * its next sibling is subtree_size nodes further. Values are records of
+ * {type, low word, high word} and are limited to scalars, a subtree whose
+ * attributes, dataset or config hold tables, arrays or functions is not
+ * static and Build() rejects it. Numbers keep their exact lepus type, and null
+ * and undefined stay apart. Parsed styles are referenced by their key only, so
+ * a subtree with parsed styles but no key is rejected as well.
+ *
+ * Keyed lists are emitted in key order rather than in the order of the hash
+ * maps of ElementInfo, so the same roots always build the same blob.
+ *
+ * Init() only validates the bounds, like FlatStringKeyTable. Instantiate()
+ * then links the whole forest with a single allocation.
+ */
+class ElementTemplateSnapshot {
+ public:
+  static constexpr uint32_t kMagic = 0x53544c45;  // "ELTS"
+  static constexpr uint32_t kVersion = 2;
+
+  enum class ValueType : uint32_t {
+    kNull = 0,
+    kBool,
+    kDouble,
+    kInt64,
+    kString,
+    kInt32,
+    kUInt32,
+    kUInt64,
+    kUndefined,
+  };
+
+  // Node of an instantiated snapshot, see Instantiate(). The string views
+  // point into the snapshot blob.
+  struct Node {
+    const Node* parent;
+    const Node* first_child;
+    const Node* next_sibling;
+    uint32_t index;
+    ElementBuiltInTagEnum tag_enum;
+    bool is_component;
+    std::string_view tag;
+    std::string_view id_selector;
+    int32_t css_id;
+  };
+
+  struct Forest {
+    std::unique_ptr<Node[]> nodes;
+    std::vector<const Node*> roots;
+  };
+
+  ElementTemplateSnapshot() = default;
+
+  // Returns std::nullopt if an element of |roots| is not static.
+  static std::optional<std::vector<uint8_t>> Build(
+      const std::vector<ElementInfo>& roots) {
+    Builder builder;
+    for (const auto& root : roots) {
+      if (!builder.AddRecursively(root)) {
+        return std::nullopt;
+      }
+    }
+    return builder.Finish(static_cast<uint32_t>(roots.size()));
+  }
+
+  // Attaches to |data|, which must outlive the snapshot. Returns false and
+  // stays empty if |data| is not a well formed snapshot.
+  bool Init(const uint8_t* data, size_t size) {
+    Reset();
+    if (data == nullptr || size < kHeaderWords * kWordSize ||
+        Load32(data) != kMagic || Load32(data + kWordSize) != kVersion) {
+      return false;
+    }
+    const uint64_t node_count = Load32(data + 2 * kWordSize);
+    const uint64_t root_count = Load32(data + 3 * kWordSize);
+    const uint64_t pool_size = Load32(data + 4 * kWordSize);
+    const uint64_t string_count = Load32(data + 5 * kWordSize);
+    const uint64_t bytes_size = Load32(data + 6 * kWordSize);
+    const uint64_t nodes_offset = kHeaderWords * kWordSize;
+    const uint64_t pool_offset =
+        nodes_offset + node_count * kNodeWords * kWordSize;
+    const uint64_t strings_offset = pool_offset + pool_size * kWordSize;
+    const uint64_t bytes_offset = strings_offset + string_count * 2 * kWordSize;
+    if (bytes_offset + bytes_size != size || string_count == 0 ||
+        root_count > node_count) {
+      return false;
+    }
+    for (uint64_t i = 0; i < string_count; ++i) {
+      const uint8_t* entry = data + strings_offset + i * 2 * kWordSize;
+      if (uint64_t(Load32(entry)) + Load32(entry + kWordSize) > bytes_size) {
+        return false;
+      }
+    }
+    data_ = data;
+    node_count_ = static_cast<uint32_t>(node_count);
+    root_count_ = static_cast<uint32_t>(root_count);
+    pool_size_ = static_cast<uint32_t>(pool_size);
+    string_count_ = static_cast<uint32_t>(string_count);
+    pool_ = data + pool_offset;
+    strings_ = data + strings_offset;
+    bytes_ = data + bytes_offset;
+    if (!ValidateNodes()) {
+      Reset();
+      return false;
+    }
+    return true;
+  }
+
+  void Reset() { *this = ElementTemplateSnapshot(); }
+
+  bool valid() const { return data_ != nullptr; }
+  uint32_t node_count() const { return node_count_; }
+  uint32_t root_count() const { return root_count_; }
+
+  // Links the nodes with one allocation for the whole forest. Per node data
+  // beyond Node is read in place with the accessors below.
+  Forest Instantiate() const {
+    Forest forest;
+    if (!valid() || node_count_ == 0) {
+      return forest;
+    }
+    forest.nodes.reset(new Node[node_count_]);
+    forest.roots.reserve(root_count_);
+    Node* nodes = forest.nodes.get();
+    // Ancestors whose subtree is still open, innermost last.
+    std::vector<uint32_t> open;
+    for (uint32_t i = 0; i < node_count_; ++i) {
+      while (!open.empty() &&
+             i >= open.back() + NodeField(open.back(), kSubtreeSize)) {
+        open.pop_back();
+      }
+      Node& node = nodes[i];
+      node.parent = open.empty() ? nullptr : &nodes[open.back()];
+      node.first_child =
+          NodeField(i, kSubtreeSize) > 1 ? &nodes[i + 1] : nullptr;
+      const uint32_t next = i + NodeField(i, kSubtreeSize);
+      const uint32_t end =
+          open.empty() ? node_count_
+                       : open.back() + NodeField(open.back(), kSubtreeSize);
+      node.next_sibling = next < end ? &nodes[next] : nullptr;
+      node.index = i;
+      node.tag_enum = static_cast<ElementBuiltInTagEnum>(NodeField(i, kTag));
+      node.is_component = NodeField(i, kFlags) & kComponentFlag;
+      node.tag = GetString(NodeField(i, kTagString));
+      node.id_selector = GetString(NodeField(i, kIdString));
+      node.css_id = static_cast<int32_t>(NodeField(i, kCssId));
+      if (node.parent == nullptr) {
+        forest.roots.push_back(&node);
+      }
+      open.push_back(i);
+    }
+    return forest;
+  }
+
+  // Per node accessors, |index| is Node::index.
+  bool HasParsedStyle(uint32_t index) const {
+    return NodeField(index, kFlags) & kParsedStyleFlag;
+  }
+  std::string_view ParsedStyleKey(uint32_t index) const {
+    return GetString(NodeField(index, kParsedStyleKey));
+  }
+  std::string_view ComponentName(uint32_t index) const {
+    return GetString(NodeField(index, kComponentName));
+  }
+  std::string_view ComponentPath(uint32_t index) const {
+    return GetString(NodeField(index, kComponentPath));
+  }
+  std::string_view ComponentId(uint32_t index) const {
+    return GetString(NodeField(index, kComponentId));
+  }
+
+  // visit(std::string_view class_name)
+  template <typename Visit>
+  void ForEachClass(uint32_t index, Visit&& visit) const {
+    ForEachRecord(index, kClasses, 1, [&](const uint8_t* record) {
+      visit(GetString(Load32(record)));
+    });
+  }
+
+  // visit(CSSPropertyID id, std::string_view value)
+  template <typename Visit>
+  void ForEachInlineStyle(uint32_t index, Visit&& visit) const {
+    ForEachRecord(index, kInlineStyles, 2, [&](const uint8_t* record) {
+      visit(static_cast<CSSPropertyID>(Load32(record)),
+            GetString(Load32(record + kWordSize)));
+    });
+  }
+
+  // visit(ElementBuiltInAttributeEnum key, lepus::Value value)
+  template <typename Visit>
+  void ForEachBuiltinAttribute(uint32_t index, Visit&& visit) const {
+    ForEachRecord(index, kBuiltinAttrs, 4, [&](const uint8_t* record) {
+      visit(static_cast<ElementBuiltInAttributeEnum>(Load32(record)),
+            LoadValue(record + kWordSize));
+    });
+  }
+
+  // visit(std::string_view key, lepus::Value value)
+  template <typename Visit>
+  void ForEachAttribute(uint32_t index, Visit&& visit) const {
+    ForEachRecord(index, kAttrs, 4, [&](const uint8_t* record) {
+      visit(GetString(Load32(record)), LoadValue(record + kWordSize));
+    });
+  }
+
+  // visit(std::string_view key, lepus::Value value)
+  template <typename Visit>
+  void ForEachDataset(uint32_t index, Visit&& visit) const {
+    ForEachRecord(index, kDataset, 4, [&](const uint8_t* record) {
+      visit(GetString(Load32(record)), LoadValue(record + kWordSize));
+    });
+  }
+
+  // visit(std::string_view type, std::string_view name, std::string_view value)
+  template <typename Visit>
+  void ForEachEvent(uint32_t index, Visit&& visit) const {
+    ForEachRecord(index, kEvents, 3, [&](const uint8_t* record) {
+      visit(GetString(Load32(record)), GetString(Load32(record + kWordSize)),
+            GetString(Load32(record + 2 * kWordSize)));
+    });
+  }
+
+ private:
+  static constexpr size_t kWordSize = 4;
+  static constexpr size_t kHeaderWords = 7;
+
+  // Node fields, in words. A list is a pool offset followed by a count.
+  enum NodeFieldIndex : uint32_t {
+    kTag = 0,
+    kFlags,
+    kTagString,
+    kIdString,
+    kCssId,
+    kSubtreeSize,
+    kParsedStyleKey,
+    kComponentName,
+    kComponentPath,
+    kComponentId,
+    kClasses,
+    kInlineStyles = kClasses + 2,
+    kBuiltinAttrs = kInlineStyles + 2,
+    kAttrs = kBuiltinAttrs + 2,
+    kDataset = kAttrs + 2,
+    kEvents = kDataset + 2,
+    kNodeWords = kEvents + 2,
+  };
+
+  // Words per record of each list.
+  static constexpr uint32_t kListRecordWords[] = {1, 2, 4, 4, 4, 3};
+
+  static constexpr uint32_t kComponentFlag = 1u << 0;
+  static constexpr uint32_t kParsedStyleFlag = 1u << 1;
+
+  static uint32_t Load32(const uint8_t* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 |
+           uint32_t(p[3]) << 24;
+  }
+
+  uint32_t NodeField(uint32_t index, uint32_t field) const {
+    return Load32(data_ + (kHeaderWords + index * kNodeWords + field) *
+                              kWordSize);
+  }
+
+  std::string_view GetString(uint32_t index) const {
+    if (index >= string_count_) {
+      return {};
+    }
+    const uint8_t* entry = strings_ + index * 2 * kWordSize;
+    return std::string_view(
+        reinterpret_cast<const char*>(bytes_ + Load32(entry)),
+        Load32(entry + kWordSize));
+  }
+
+  template <typename Visit>
+  void ForEachRecord(uint32_t index, uint32_t list, uint32_t record_words,
+                     Visit&& visit) const {
+    const uint32_t offset = NodeField(index, list);
+    const uint32_t count = NodeField(index, list + 1);
+    for (uint32_t i = 0; i < count; ++i) {
+      visit(pool_ + (uint64_t(offset) + uint64_t(i) * record_words) *
+                        kWordSize);
+    }
+  }
+
+  lepus::Value LoadValue(const uint8_t* record) const {
+    const uint32_t low = Load32(record + kWordSize);
+    const uint64_t bits =
+        uint64_t(low) | uint64_t(Load32(record + 2 * kWordSize)) << 32;
+    switch (static_cast<ValueType>(Load32(record))) {
+      case ValueType::kBool:
+        return lepus::Value(low != 0);
+      case ValueType::kDouble: {
+        double number;
+        memcpy(&number, &bits, sizeof(number));
+        return lepus::Value(number);
+      }
+      case ValueType::kInt32:
+        return lepus::Value(static_cast<int32_t>(low));
+      case ValueType::kUInt32:
+        return lepus::Value(low);
+      case ValueType::kInt64:
+        return lepus::Value(static_cast<int64_t>(bits));
+      case ValueType::kUInt64:
+        return lepus::Value(bits);
+      case ValueType::kString: {
+        const std::string_view string = GetString(low);
+        return lepus::Value(base::String(string.data(), string.size()));
+      }
+      case ValueType::kUndefined:
+        return lepus::Value(lepus::Value::kCreateAsUndefinedTag);
+      case ValueType::kNull:
+        break;
+    }
+    return lepus::Value();
+  }
+
+  bool ValidateNodes() const {
+    uint32_t roots = 0;
+    for (uint32_t i = 0; i < node_count_;
+         i += NodeField(i, kSubtreeSize), ++roots) {
+      if (NodeField(i, kSubtreeSize) == 0) {
+        return false;
+      }
+    }
+    if (roots != root_count_) {
+      return false;
+    }
+    for (uint32_t i = 0; i < node_count_; ++i) {
+      const uint64_t subtree_size = NodeField(i, kSubtreeSize);
+      if (subtree_size == 0 || i + subtree_size > node_count_) {
+        return false;
+      }
+      for (uint32_t list = 0; list < 6; ++list) {
+        const uint32_t field = kClasses + 2 * list;
+        if (uint64_t(NodeField(i, field)) +
+                uint64_t(NodeField(i, field + 1)) * kListRecordWords[list] >
+            pool_size_) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  class Builder {
+   public:
+    Builder() { Intern(std::string()); }
+
+    bool AddRecursively(const ElementInfo& info) {
+      if (!info.config_.IsEmpty() ||
+          (info.parsed_styles_ && info.parser_style_key_.empty())) {
+        return false;
+      }
+      const size_t index = nodes_.size() / kNodeWords;
+      nodes_.resize(nodes_.size() + kNodeWords, 0);
+      Set(index, kTag, static_cast<uint32_t>(info.tag_enum_));
+      Set(index, kFlags,
+          (info.is_component_ ? kComponentFlag : 0) |
+              (info.has_parser_style_ ? kParsedStyleFlag : 0));
+      Set(index, kTagString, Intern(info.tag_.str()));
+      Set(index, kIdString, Intern(info.id_selector_.str()));
+      Set(index, kCssId, static_cast<uint32_t>(info.css_id_));
+      Set(index, kParsedStyleKey, Intern(info.parser_style_key_.str()));
+      Set(index, kComponentName, Intern(info.component_name_.str()));
+      Set(index, kComponentPath, Intern(info.component_path_.str()));
+      Set(index, kComponentId, Intern(info.component_id_.str()));
+
+      BeginList(index, kClasses);
+      for (const auto& name : info.class_selector_) {
+        pool_.push_back(Intern(name.str()));
+      }
+      EndList(index, kClasses, 1);
+
+      BeginList(index, kInlineStyles);
+      for (const auto* entry : SortedEntries(info.inline_styles_)) {
+        pool_.push_back(static_cast<uint32_t>(entry->first));
+        pool_.push_back(Intern(entry->second.str()));
+      }
+      EndList(index, kInlineStyles, 2);
+
+      BeginList(index, kBuiltinAttrs);
+      for (const auto* entry : SortedEntries(info.builtin_attrs_)) {
+        pool_.push_back(static_cast<uint32_t>(entry->first));
+        if (!PushValue(entry->second)) {
+          return false;
+        }
+      }
+      EndList(index, kBuiltinAttrs, 4);
+
+      BeginList(index, kAttrs);
+      for (const auto* entry : SortedEntries(info.attrs_)) {
+        pool_.push_back(Intern(entry->first.str()));
+        if (!PushValue(entry->second)) {
+          return false;
+        }
+      }
+      EndList(index, kAttrs, 4);
+
+      BeginList(index, kDataset);
+      if (!info.data_set_.IsEmpty()) {
+        if (!info.data_set_.IsTable()) {
+          return false;
+        }
+        std::vector<std::pair<std::string, lepus::Value>> dataset;
+        lepus::Value::ForEachLepusValue(
+            info.data_set_,
+            [&dataset](const lepus::Value& key, const lepus::Value& value) {
+              dataset.emplace_back(key.StdString(), value);
+            });
+        std::sort(dataset.begin(), dataset.end(),
+                  [](const auto& lhs, const auto& rhs) {
+                    return lhs.first < rhs.first;
+                  });
+        for (const auto& [key, value] : dataset) {
+          pool_.push_back(Intern(key));
+          if (!PushValue(value)) {
+            return false;
+          }
+        }
+      }
+      EndList(index, kDataset, 4);
+
+      BeginList(index, kEvents);
+      for (const auto& event : info.events_) {
+        pool_.push_back(Intern(event.type_.str()));
+        pool_.push_back(Intern(event.name_.str()));
+        pool_.push_back(Intern(event.value_.str()));
+      }
+      EndList(index, kEvents, 3);
+
+      for (const auto& child : info.children_) {
+        if (!AddRecursively(child)) {
+          return false;
+        }
+      }
+      Set(index, kSubtreeSize,
+          static_cast<uint32_t>(nodes_.size() / kNodeWords - index));
+      return true;
+    }
+
+    std::vector<uint8_t> Finish(uint32_t root_count) {
+      std::vector<uint8_t> blob;
+      const uint32_t header[kHeaderWords] = {
+          kMagic,
+          kVersion,
+          static_cast<uint32_t>(nodes_.size() / kNodeWords),
+          root_count,
+          static_cast<uint32_t>(pool_.size()),
+          static_cast<uint32_t>(string_entries_.size() / 2),
+          static_cast<uint32_t>(bytes_.size())};
+      for (uint32_t word : header) {
+        Store32(blob, word);
+      }
+      for (uint32_t word : nodes_) {
+        Store32(blob, word);
+      }
+      for (uint32_t word : pool_) {
+        Store32(blob, word);
+      }
+      for (uint32_t word : string_entries_) {
+        Store32(blob, word);
+      }
+      blob.insert(blob.end(), bytes_.begin(), bytes_.end());
+      return blob;
+    }
+
+   private:
+    static void Store32(std::vector<uint8_t>& blob, uint32_t word) {
+      for (int shift = 0; shift < 32; shift += 8) {
+        blob.push_back(static_cast<uint8_t>(word >> shift));
+      }
+    }
+
+    // Entries of |map| ordered by key.
+    template <typename Map>
+    static std::vector<const typename Map::value_type*> SortedEntries(
+        const Map& map) {
+      std::vector<const typename Map::value_type*> entries;
+      entries.reserve(map.size());
+      for (const auto& entry : map) {
+        entries.push_back(&entry);
+      }
+      std::sort(entries.begin(), entries.end(),
+                [](const auto* lhs, const auto* rhs) {
+                  return lhs->first < rhs->first;
+                });
+      return entries;
+    }
+
+    void Set(size_t index, uint32_t field, uint32_t value) {
+      nodes_[index * kNodeWords + field] = value;
+    }
+
+    void BeginList(size_t index, uint32_t list) {
+      Set(index, list, static_cast<uint32_t>(pool_.size()));
+    }
+
+    void EndList(size_t index, uint32_t list, uint32_t record_words) {
+      const uint32_t offset = nodes_[index * kNodeWords + list];
+      Set(index, list + 1,
+          (static_cast<uint32_t>(pool_.size()) - offset) / record_words);
+    }
+
+    uint32_t Intern(const std::string& string) {
+      auto [it, inserted] = string_indices_.emplace(
+          string, static_cast<uint32_t>(string_entries_.size() / 2));
+      if (inserted) {
+        string_entries_.push_back(static_cast<uint32_t>(bytes_.size()));
+        string_entries_.push_back(static_cast<uint32_t>(string.size()));
+        bytes_.insert(bytes_.end(), string.begin(), string.end());
+      }
+      return it->second;
+    }
+
+    // Pushes {type, low, high}. Returns false for a non scalar value.
+    bool PushValue(const lepus::Value& value) {
+      ValueType type = ValueType::kNull;
+      uint64_t bits = 0;
+      if (value.IsString()) {
+        type = ValueType::kString;
+        bits = Intern(value.StdString());
+      } else if (value.IsBool()) {
+        type = ValueType::kBool;
+        bits = value.Bool() ? 1 : 0;
+      } else if (value.IsInt32()) {
+        type = ValueType::kInt32;
+        bits = static_cast<uint32_t>(value.Int32());
+      } else if (value.IsUInt32()) {
+        type = ValueType::kUInt32;
+        bits = value.UInt32();
+      } else if (value.IsUInt64()) {
+        type = ValueType::kUInt64;
+        bits = value.UInt64();
+      } else if (value.IsInt64()) {
+        type = ValueType::kInt64;
+        bits = static_cast<uint64_t>(value.Int64());
+      } else if (value.IsNumber()) {
+        type = ValueType::kDouble;
+        const double number = value.Number();
+        memcpy(&bits, &number, sizeof(bits));
+      } else if (value.IsUndefined()) {
+        type = ValueType::kUndefined;
+      } else if (!value.IsEmpty()) {
+        return false;
+      }
+      pool_.push_back(static_cast<uint32_t>(type));
+      pool_.push_back(static_cast<uint32_t>(bits));
+      pool_.push_back(static_cast<uint32_t>(bits >> 32));
+      return true;
+    }
+
+    std::vector<uint32_t> nodes_;
+    std::vector<uint32_t> pool_;
+    std::vector<uint32_t> string_entries_;
+    std::vector<uint8_t> bytes_;
+    std::unordered_map<std::string, uint32_t> string_indices_;
+  };
+
+  const uint8_t* data_{nullptr};
+  const uint8_t* pool_{nullptr};
+  const uint8_t* strings_{nullptr};
+  const uint8_t* bytes_{nullptr};
+  uint32_t node_count_{0};
+  uint32_t root_count_{0};
+  uint32_t pool_size_{0};
+  uint32_t string_count_{0};
+};
+
+}  // namespace tasm
+}  // namespace lynx
+
+#endif  // CORE_RENDERER_UTILS_BASE_ELEMENT_TEMPLATE_SNAPSHOT_H_
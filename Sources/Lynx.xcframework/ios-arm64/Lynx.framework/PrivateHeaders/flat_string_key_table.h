@@ -0,0 +1,292 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_TEMPLATE_BUNDLE_TEMPLATE_CODEC_FLAT_STRING_KEY_TABLE_H_
+#define CORE_TEMPLATE_BUNDLE_TEMPLATE_CODEC_FLAT_STRING_KEY_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace lynx {
+namespace tasm {
+
+/**
+ * Serialized map from string keys to uint32 values, such as the section
+ * offsets of StringKeyRouter, which is queried in place from the template
+ * buffer (or a mmapped file) instead of being decoded into a hash map.
+ *
+ * Layout, every integer is a little endian uint32 and nothing needs to be
+ * aligned:
+ *
+ *   count
+ *   entries[count]  {hash, key_offset, key_length, value}, insertion order
+ *   sorted[count]   indices into entries ordered by (hash, key)
+ *   keys            key bytes, key_offset is relative to this blob
+ *
+ * Find() binary searches |sorted| for the FNV-1a hash of the key and compares
+ * the bytes of the candidates sharing that hash. Init() only validates the
+ * bounds of the buffer, so attaching a table never allocates per key.
+ *
+ * The table either owns its buffer, see Adopt(), or borrows it together with
+ * a reference to its owner, e.g. the mapping or the stream buffer the table
+ * was read from, so that the buffer lives as long as any copy of the table.
+ */
+class FlatStringKeyTable {
+ public:
+  FlatStringKeyTable() = default;
+
+  // Attaches to |data|, which |owner| keeps alive. Returns false and stays
+  // empty if |data| is not a well formed table.
+  bool Init(const uint8_t* data, size_t size,
+            std::shared_ptr<const void> owner) {
+    if (!Attach(data, size)) {
+      return false;
+    }
+    owner_ = std::move(owner);
+    return true;
+  }
+
+  // Takes |buffer|, e.g. the result of FlatStringKeyTableBuilder::Finish().
+  bool Adopt(std::vector<uint8_t> buffer) {
+    auto owned =
+        std::make_shared<const std::vector<uint8_t>>(std::move(buffer));
+    return Init(owned->data(), owned->size(), owned);
+  }
+
+  void Reset() {
+    data_ = nullptr;
+    byte_size_ = 0;
+    count_ = 0;
+    owner_.reset();
+  }
+
+  bool valid() const { return data_ != nullptr; }
+
+  size_t size() const { return count_; }
+
+  bool empty() const { return count_ == 0; }
+
+  const uint8_t* data() const { return data_; }
+
+  size_t byte_size() const { return byte_size_; }
+
+  std::optional<uint32_t> Find(std::string_view key) const {
+    if (count_ == 0) {
+      return std::nullopt;
+    }
+    const uint32_t hash = Hash(key);
+    const uint8_t* sorted = Sorted();
+    const std::pair<uint32_t, std::string_view> target(hash, key);
+    // Lower bound of |target| in |sorted|.
+    size_t position = 0;
+    for (size_t length = count_; length > 0;) {
+      const size_t half = length / 2;
+      if (SortKeyAt(sorted, position + half) < target) {
+        position += half + 1;
+        length -= half + 1;
+      } else {
+        length = half;
+      }
+    }
+    for (; position < count_; ++position) {
+      const uint8_t* entry = EntryAt(Load32(sorted + position * kWordSize));
+      if (Load32(entry + kHashField) != hash) {
+        break;
+      }
+      if (KeyOf(entry) == key) {
+        return Load32(entry + kValueField);
+      }
+    }
+    return std::nullopt;
+  }
+
+  bool Contains(std::string_view key) const { return Find(key).has_value(); }
+
+  // Visits entries in insertion order as callback(key, value).
+  template <typename Callback>
+  void ForEach(Callback&& callback) const {
+    for (size_t i = 0; i < count_; ++i) {
+      const uint8_t* entry = EntryAt(i);
+      callback(KeyOf(entry), Load32(entry + kValueField));
+    }
+  }
+
+  // 32 bit FNV-1a, part of the format.
+  static uint32_t Hash(std::string_view key) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : key) {
+      hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+  }
+
+ private:
+  friend class FlatStringKeyTableBuilder;
+
+  static constexpr size_t kWordSize = sizeof(uint32_t);
+  static constexpr size_t kHashField = 0;
+  static constexpr size_t kKeyOffsetField = kWordSize;
+  static constexpr size_t kKeyLengthField = 2 * kWordSize;
+  static constexpr size_t kValueField = 3 * kWordSize;
+  static constexpr size_t kEntrySize = 4 * kWordSize;
+
+  static uint32_t Load32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 |
+           static_cast<uint32_t>(p[3]) << 24;
+  }
+
+  static void Store32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+  }
+
+  const uint8_t* EntryAt(size_t index) const {
+    return data_ + kWordSize + index * kEntrySize;
+  }
+
+  const uint8_t* Sorted() const { return EntryAt(count_); }
+
+  const char* Keys() const {
+    return reinterpret_cast<const char*>(Sorted() + count_ * kWordSize);
+  }
+
+  std::string_view KeyOf(const uint8_t* entry) const {
+    return std::string_view(Keys() + Load32(entry + kKeyOffsetField),
+                            Load32(entry + kKeyLengthField));
+  }
+
+  std::pair<uint32_t, std::string_view> SortKeyAt(const uint8_t* sorted,
+                                                  size_t position) const {
+    const uint8_t* entry = EntryAt(Load32(sorted + position * kWordSize));
+    return {Load32(entry + kHashField), KeyOf(entry)};
+  }
+
+  // Validates and attaches without taking any owner.
+  bool Attach(const uint8_t* data, size_t size) {
+    Reset();
+    if (data == nullptr || size < kWordSize) {
+      return false;
+    }
+    const uint64_t count = Load32(data);
+    const uint64_t header_size = kWordSize + count * (kEntrySize + kWordSize);
+    if (header_size > size) {
+      return false;
+    }
+    const uint8_t* entries = data + kWordSize;
+    const uint8_t* sorted = entries + count * kEntrySize;
+    const uint64_t keys_size = size - header_size;
+    for (uint64_t i = 0; i < count; ++i) {
+      const uint8_t* entry = entries + i * kEntrySize;
+      const uint64_t key_offset = Load32(entry + kKeyOffsetField);
+      const uint64_t key_length = Load32(entry + kKeyLengthField);
+      if (key_offset + key_length > keys_size ||
+          Load32(sorted + i * kWordSize) >= count) {
+        return false;
+      }
+    }
+    data_ = data;
+    byte_size_ = static_cast<size_t>(header_size + keys_size);
+    count_ = static_cast<size_t>(count);
+    return true;
+  }
+
+  const uint8_t* data_{nullptr};
+  size_t byte_size_{0};
+  size_t count_{0};
+  std::shared_ptr<const void> owner_;
+};
+
+/**
+ * Encodes a FlatStringKeyTable. Keys added twice keep their first value, like
+ * inserting into the map based routers.
+ */
+class FlatStringKeyTableBuilder {
+ public:
+  void Add(std::string key, uint32_t value) {
+    entries_.emplace_back(std::move(key), value);
+  }
+
+  size_t size() const { return entries_.size(); }
+
+  std::vector<uint8_t> Finish() const {
+    using Table = FlatStringKeyTable;
+    std::vector<uint32_t> hashes(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      hashes[i] = Table::Hash(entries_[i].first);
+    }
+    std::vector<uint32_t> order(entries_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return std::make_pair(hashes[a], std::string_view(entries_[a].first)) <
+             std::make_pair(hashes[b], std::string_view(entries_[b].first));
+    });
+    // Drops later duplicates, the stable sort keeps the first one in front.
+    std::vector<bool> dropped(entries_.size(), false);
+    for (size_t i = 1; i < order.size(); ++i) {
+      if (entries_[order[i]].first == entries_[order[i - 1]].first) {
+        dropped[order[i]] = true;
+      }
+    }
+    std::vector<uint32_t> remap(entries_.size());
+    uint32_t count = 0;
+    size_t keys_size = 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      if (!dropped[i]) {
+        remap[i] = count++;
+        keys_size += entries_[i].first.size();
+      }
+    }
+
+    std::vector<uint8_t> result(Table::kWordSize +
+                                count * (Table::kEntrySize + Table::kWordSize) +
+                                keys_size);
+    uint8_t* cursor = result.data();
+    Table::Store32(cursor, count);
+    cursor += Table::kWordSize;
+    uint8_t* sorted = cursor + count * Table::kEntrySize;
+    char* keys = reinterpret_cast<char*>(sorted + count * Table::kWordSize);
+    uint32_t key_offset = 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      if (dropped[i]) {
+        continue;
+      }
+      const std::string& key = entries_[i].first;
+      Table::Store32(cursor + Table::kHashField, hashes[i]);
+      Table::Store32(cursor + Table::kKeyOffsetField, key_offset);
+      Table::Store32(cursor + Table::kKeyLengthField,
+                     static_cast<uint32_t>(key.size()));
+      Table::Store32(cursor + Table::kValueField, entries_[i].second);
+      std::memcpy(keys + key_offset, key.data(), key.size());
+      key_offset += static_cast<uint32_t>(key.size());
+      cursor += Table::kEntrySize;
+    }
+    for (uint32_t index : order) {
+      if (!dropped[index]) {
+        Table::Store32(sorted, remap[index]);
+        sorted += Table::kWordSize;
+      }
+    }
+    return result;
+  }
+
+ private:
+  std::vector<std::pair<std::string, uint32_t>> entries_;
+};
+
+}  // namespace tasm
+}  // namespace lynx
+
+#endif  // CORE_TEMPLATE_BUNDLE_TEMPLATE_CODEC_FLAT_STRING_KEY_TABLE_H_
@@ -33,6 +33,12 @@ class LynxBinaryReader : public LynxBinaryBaseTemplateReader {
 
   static LynxBinaryReader CreateLynxBinaryReader(std::vector<uint8_t> binary);
 
+  // Reads from |stream| without copying it, e.g. a lepus::MmapInputStream.
+  static LynxBinaryReader CreateLynxBinaryReader(
+      std::unique_ptr<lepus::InputStream> stream) {
+    return LynxBinaryReader(std::move(stream));
+  }
+
   LynxTemplateBundle GetTemplateBundle();
 
  protected:
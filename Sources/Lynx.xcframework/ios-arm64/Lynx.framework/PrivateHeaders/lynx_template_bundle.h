@@ -59,6 +59,7 @@ class LepusChunkManager {
 
   friend class TemplateBinaryReader;
   friend class LynxBinaryReader;
+  friend class LynxTemplateBundleCache;
 };
 // LynxTemplateBundle is used to hold the result of DecodeResult.
 // It is usually used when user needs to decode a template without loading
@@ -248,6 +249,7 @@ class LynxTemplateBundle final {
   friend class TemplateAssembler;
   friend class TemplateEntry;
   friend class LynxTemplateBundleConverter;
+  friend class LynxTemplateBundleCache;
 };
 }  // namespace tasm
 }  // namespace lynx
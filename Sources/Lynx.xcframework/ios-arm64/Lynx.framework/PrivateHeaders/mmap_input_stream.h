@@ -0,0 +1,236 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_RUNTIME_VM_LEPUS_MMAP_INPUT_STREAM_H_
+#define CORE_RUNTIME_VM_LEPUS_MMAP_INPUT_STREAM_H_
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__APPLE__)
+#include <sys/clonefile.h>
+#endif
+
+#include "core/runtime/vm/lepus/binary_input_stream.h"
+
+namespace lynx {
+namespace lepus {
+
+/**
+ * Private copy-on-write mapping of a whole file. The pages are only loaded,
+ * and only count towards the RSS, when they are touched, and as long as they
+ * are not written they are clean so the kernel may drop them under memory
+ * pressure instead of swapping. A write only copies the page it touches and
+ * never reaches the file.
+ *
+ * Touching a page of a mapping whose file was truncated meanwhile raises
+ * SIGBUS, so a file is only mapped in place when its writers promise to
+ * replace it by rename() and never truncate or rewrite it, see
+ * MappingMode::kImmutableFile. Otherwise the mapping is taken from a private
+ * clone of the file, which is unlinked as soon as it is opened so no other
+ * process can reach it. On APFS a clone shares the blocks of the original
+ * until either is written, so this costs no copy. Where files can not be
+ * cloned, and on platforms without mmap, the file is read into memory.
+ */
+class MappedFile {
+ public:
+  enum class MappingMode {
+    // Mapped from an unlinked private clone, or read into memory.
+    kPrivateSnapshot,
+    // Mapped in place, the file is only ever replaced by rename().
+    kImmutableFile,
+  };
+
+  // Returns nullptr if the file can not be opened or is empty.
+  static std::shared_ptr<const MappedFile> Open(
+      const char* path, MappingMode mode = MappingMode::kPrivateSnapshot) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    if (!file->Map(path, mode)) {
+      return nullptr;
+    }
+    return file;
+  }
+
+  ~MappedFile() {
+#if !defined(_WIN32)
+    if (is_mapped_) {
+      munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // False if the file was read into memory.
+  bool is_mapped() const { return is_mapped_; }
+
+  // A copy of the bytes, e.g. for LynxTemplateBundle::SetBinary() when
+  // devtool needs the original binary.
+  std::vector<uint8_t> Copy() const {
+    return std::vector<uint8_t>(data_, data_ + size_);
+  }
+
+ private:
+  MappedFile() = default;
+
+  bool Map(const char* path, MappingMode mode) {
+#if !defined(_WIN32)
+    if (mode == MappingMode::kImmutableFile) {
+      return MapFile(open(path, O_RDONLY | O_CLOEXEC));
+    }
+#if defined(__APPLE__)
+    const std::string clone_path = NewClonePath();
+    if (!clone_path.empty() && clonefile(path, clone_path.c_str(), 0) == 0) {
+      const int fd = open(clone_path.c_str(), O_RDONLY | O_CLOEXEC);
+      // The open descriptor keeps the clone alive, nobody else can reach it.
+      unlink(clone_path.c_str());
+      if (MapFile(fd)) {
+        return true;
+      }
+    }
+#endif
+#endif
+    return ReadFile(path);
+  }
+
+#if !defined(_WIN32)
+  // Takes ownership of |fd|.
+  bool MapFile(int fd) {
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+      close(fd);
+      return false;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    // Writable so that decoders may write in place as with the other
+    // streams, MAP_PRIVATE keeps the writes out of the file.
+    void* addr =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    // Templates are decoded mostly front to back.
+    madvise(addr, size, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t*>(addr);
+    size_ = size;
+    is_mapped_ = true;
+    return true;
+  }
+#endif
+
+#if defined(__APPLE__)
+  // A fresh path in the temporary directory of the app, which is on the same
+  // volume as its caches as clonefile() requires.
+  static std::string NewClonePath() {
+    static std::atomic<uint32_t> counter{0};
+    char dir[PATH_MAX];
+    const size_t length = confstr(_CS_DARWIN_USER_TEMP_DIR, dir, sizeof(dir));
+    if (length == 0 || length > sizeof(dir)) {
+      return std::string();
+    }
+    return std::string(dir) + "lynx_template_" + std::to_string(getpid()) +
+           "_" + std::to_string(counter.fetch_add(1)) + ".clone";
+  }
+#endif
+
+  bool ReadFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+      return false;
+    }
+    std::vector<uint8_t> buffer;
+    uint8_t chunk[16 * 1024];
+    size_t read = 0;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+      buffer.insert(buffer.end(), chunk, chunk + read);
+    }
+    fclose(file);
+    if (buffer.empty()) {
+      return false;
+    }
+    fallback_ = std::move(buffer);
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+    return true;
+  }
+
+  std::vector<uint8_t> fallback_;
+  const uint8_t* data_{nullptr};
+  size_t size_{0};
+  bool is_mapped_{false};
+};
+
+/**
+ * InputStream reading a template straight from a MappedFile, without the heap
+ * copy of ByteArrayInputStream. Derived streams share the mapping, which is
+ * unmapped with the last of them.
+ *
+ * Writes through begin() or cursor() land in copy-on-write pages of the
+ * mapping, shared with the derived streams like the buffer of a derived
+ * ByteArrayInputStream.
+ *
+ * Pass it to LynxBinaryReader::CreateLynxBinaryReader(). The bundle does not
+ * keep the mapping: when devtool needs the original binary, hand it
+ * mapped_file()->Copy() through LynxTemplateBundle::SetBinary().
+ */
+class MmapInputStream : public InputStream {
+ public:
+  explicit MmapInputStream(std::shared_ptr<const MappedFile> file)
+      : file_(std::move(file)) {}
+
+  // Returns nullptr if |path| can not be mapped.
+  static std::unique_ptr<MmapInputStream> Open(
+      const char* path, MappedFile::MappingMode mode =
+                            MappedFile::MappingMode::kPrivateSnapshot) {
+    auto file = MappedFile::Open(path, mode);
+    if (!file) {
+      return nullptr;
+    }
+    return std::make_unique<MmapInputStream>(std::move(file));
+  }
+
+  MmapInputStream(const MmapInputStream&) = delete;
+  MmapInputStream& operator=(const MmapInputStream&) = delete;
+
+  const std::shared_ptr<const MappedFile>& mapped_file() const {
+    return file_;
+  }
+
+  uint8_t* begin() override { return const_cast<uint8_t*>(file_->data()); }
+  uint8_t* end() override { return begin() + file_->size(); }
+  size_t size() override { return file_->size(); }
+
+  std::unique_ptr<InputStream> DeriveInputStream() override {
+    return std::make_unique<MmapInputStream>(file_);
+  }
+
+ private:
+  std::shared_ptr<const MappedFile> file_;
+};
+
+}  // namespace lepus
+}  // namespace lynx
+
+#endif  // CORE_RUNTIME_VM_LEPUS_MMAP_INPUT_STREAM_H_
@@ -0,0 +1,142 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_MONOTONIC_ARENA_H_
+#define BASE_INCLUDE_MONOTONIC_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "base/include/fml/macros.h"
+
+namespace lynx {
+namespace base {
+
+/**
+ MonotonicArena is a bump allocator for short lived temporaries, such as the
+ StyleMaps built and torn down during one style resolve pass.
+
+ Allocate() only moves a cursor inside the current block and falls back to
+ malloc for a new block when the current one is exhausted. Individual
+ allocations are never freed; Reset() drops everything at once and keeps the
+ first block so that the next pass starts without any malloc.
+
+ Destructors of objects placed on the arena are not run by the arena. Not
+ thread safe.
+ */
+class MonotonicArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  explicit MonotonicArena(size_t block_size = kDefaultBlockSize)
+      : block_size_(block_size > sizeof(Block) ? block_size
+                                                : kDefaultBlockSize) {}
+
+  ~MonotonicArena() { FreeBlocks(head_); }
+
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    uintptr_t aligned = (cursor_ + alignment - 1) & ~(alignment - 1);
+    if (head_ == nullptr || aligned + size > limit_) {
+      NewBlock(size + alignment);
+      aligned = (cursor_ + alignment - 1) & ~(alignment - 1);
+    }
+    cursor_ = aligned + size;
+    allocated_bytes_ += size;
+    ++allocation_count_;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  // Drops all allocations. The first block is kept for reuse, the rest are
+  // returned to the system.
+  void Reset() {
+    if (head_ == nullptr) {
+      return;
+    }
+    Block* first = head_;
+    while (first->next != nullptr) {
+      first = first->next;
+    }
+    if (first != head_) {
+      // Detach the first block and free the newer ones.
+      Block* block = head_;
+      while (block->next != first) {
+        block = block->next;
+      }
+      block->next = nullptr;
+      FreeBlocks(head_);
+      head_ = first;
+      block_count_ = 1;
+    }
+    cursor_ = head_->begin();
+    limit_ = head_->end();
+    allocated_bytes_ = 0;
+    allocation_count_ = 0;
+  }
+
+  // Bytes handed out since construction or the last Reset().
+  size_t allocated_bytes() const { return allocated_bytes_; }
+
+  // Allocate() calls since construction or the last Reset().
+  size_t allocation_count() const { return allocation_count_; }
+
+  // Blocks currently held, i.e. the number of mallocs not yet returned.
+  size_t block_count() const { return block_count_; }
+
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+
+    uintptr_t begin() { return reinterpret_cast<uintptr_t>(this + 1); }
+    uintptr_t end() { return reinterpret_cast<uintptr_t>(this) + size; }
+  };
+
+  void NewBlock(size_t min_payload) {
+    size_t size = block_size_;
+    if (size < min_payload + sizeof(Block)) {
+      size = min_payload + sizeof(Block);
+    }
+    Block* block = static_cast<Block*>(std::malloc(size));
+    if (block == nullptr) {
+      // Base is built without exceptions.
+      abort();
+    }
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+    cursor_ = block->begin();
+    limit_ = block->end();
+    ++block_count_;
+  }
+
+  static void FreeBlocks(Block* block) {
+    while (block != nullptr) {
+      Block* next = block->next;
+      std::free(block);
+      block = next;
+    }
+  }
+
+  const size_t block_size_;
+  // Newest block first.
+  Block* head_{nullptr};
+  uintptr_t cursor_{0};
+  uintptr_t limit_{0};
+  size_t allocated_bytes_{0};
+  size_t allocation_count_{0};
+  size_t block_count_{0};
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(MonotonicArena);
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_MONOTONIC_ARENA_H_
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <utility>
 
@@ -49,6 +50,13 @@ class OnceTask : public fml::RefCountedThreadSafeStorage {
     return false;
   }
 
+  // Returns true if the task will never run, i.e. it had not been started.
+  // The future of a cancelled task is never ready.
+  bool Cancel() {
+    bool expected_run = false;
+    return started_.compare_exchange_strong(expected_run, true);
+  }
+
  private:
   std::atomic_bool started_;
   base::MoveOnlyClosure<void, Args...> task_;
@@ -58,6 +66,22 @@ class OnceTask : public fml::RefCountedThreadSafeStorage {
 template <typename T, typename... Args>
 using OnceTaskRefptr = fml::RefPtr<OnceTask<T, Args...>>;
 
+// Wraps |task| into a OnceTask whose future receives its result and hands it
+// to |poster|, e.g. a post to the concurrent loop. Like the parallel flush of
+// elements, the caller then calls Run() on the returned task to run it itself
+// if no worker started it yet, and waits for the future, or calls Cancel().
+template <typename T, typename Poster>
+OnceTaskRefptr<T> PostOnceTask(base::MoveOnlyClosure<T> task, Poster& poster) {
+  auto promise = std::make_shared<std::promise<T>>();
+  auto once_task = fml::MakeRefCounted<OnceTask<T>>(
+      [task = std::move(task), promise]() mutable {
+        promise->set_value(task());
+      },
+      promise->get_future());
+  poster([once_task]() { once_task->Run(); });
+  return once_task;
+}
+
 }  // namespace base
 }  // namespace lynx
 
@@ -0,0 +1,147 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_RENDERER_DOM_PARALLEL_REDUCE_EXECUTOR_H_
+#define CORE_RENDERER_DOM_PARALLEL_REDUCE_EXECUTOR_H_
+
+#include <cstdint>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include "base/include/closure.h"
+#include "base/include/fml/macros.h"
+#include "base/include/fml/memory/ref_ptr.h"
+#include "base/include/timer/time_utils.h"
+#include "core/base/thread/once_task.h"
+#include "core/base/threading/task_runner_manufactor.h"
+
+namespace lynx {
+namespace tasm {
+
+// Times in microseconds of one item of a ParallelReduceExecutor, 0 until the
+// phase ran.
+struct ParallelReduceTimings {
+  // Resolving the subtree of the item, possibly on the concurrent loop.
+  double resolve_duration() const {
+    if (end_resolve_time_ != 0 && start_resolve_time_ != 0) {
+      return (end_resolve_time_ - start_resolve_time_) / 1000.f;
+    }
+    return 0;
+  }
+
+  // Merging the resolved subtree of the item on the TASM thread.
+  double reduce_duration() const {
+    if (end_reduce_time_ != 0 && start_reduce_time_ != 0) {
+      return (end_reduce_time_ - start_reduce_time_) / 1000.f;
+    }
+    return 0;
+  }
+
+  uint64_t start_resolve_time_{0};
+  uint64_t end_resolve_time_{0};
+  uint64_t start_reduce_time_{0};
+  uint64_t end_reduce_time_{0};
+};
+
+/**
+ * Map/reduce executor for the independent subtrees of list items.
+ *
+ * Submit() posts a map task, which resolves one subtree on the concurrent loop
+ * and returns the reduce task to apply its result on the TASM thread. Reduce()
+ * then runs the reduce tasks in submission order, whatever the order the map
+ * tasks completed in, so the merged result does not depend on the scheduling.
+ * A map task not picked up by a worker yet is run by Reduce() itself, like the
+ * parallel flush of elements, so a busy concurrent loop never stalls the TASM
+ * thread.
+ *
+ * Destroying the executor drops the pending reduce tasks: the map tasks no
+ * worker started are cancelled and the running ones are waited for, since
+ * they may still use what they captured, but nothing is merged.
+ *
+ * Submit() and Reduce() must be called on the TASM thread.
+ */
+class ParallelReduceExecutor {
+ public:
+  using MapTask = base::MoveOnlyClosure<base::closure>;
+  using Poster = base::MoveOnlyClosure<void, base::closure>;
+
+  ParallelReduceExecutor()
+      : ParallelReduceExecutor([](base::closure task) {
+          base::TaskRunnerManufactor::PostTaskToConcurrentLoop(
+              std::move(task), base::ConcurrentTaskType::HIGH_PRIORITY);
+        }) {}
+
+  // |poster| runs the map tasks, for instance on a given concurrent loop.
+  explicit ParallelReduceExecutor(Poster poster)
+      : poster_(std::move(poster)) {}
+
+  ~ParallelReduceExecutor() {
+    for (auto& entry : entries_) {
+      if (!entry.task->Cancel()) {
+        entry.task->GetFuture().wait();
+      }
+    }
+  }
+
+  // |timings|, if not null, receives the resolve and reduce times of the item
+  // and must stay alive until Reduce() returns.
+  void Submit(MapTask map, ParallelReduceTimings* timings = nullptr) {
+    auto task = base::PostOnceTask<base::closure>(
+        [map = std::move(map), timings]() mutable {
+          if (timings) {
+            timings->start_resolve_time_ =
+                base::CurrentSystemTimeMicroseconds();
+          }
+          base::closure reduce = map();
+          if (timings) {
+            timings->end_resolve_time_ = base::CurrentSystemTimeMicroseconds();
+          }
+          return reduce;
+        },
+        poster_);
+    entries_.push_back({std::move(task), timings});
+  }
+
+  bool Empty() const { return entries_.empty(); }
+
+  // Returns the number of reduce tasks run.
+  size_t Reduce() {
+    auto entries = std::move(entries_);
+    entries_.clear();
+    for (auto& entry : entries) {
+      // Runs the map task here if no worker started it yet.
+      entry.task->Run();
+      base::closure reduce = entry.task->GetFuture().get();
+      if (entry.timings) {
+        entry.timings->start_reduce_time_ =
+            base::CurrentSystemTimeMicroseconds();
+      }
+      if (reduce) {
+        reduce();
+      }
+      if (entry.timings) {
+        entry.timings->end_reduce_time_ =
+            base::CurrentSystemTimeMicroseconds();
+      }
+    }
+    return entries.size();
+  }
+
+ private:
+  struct Entry {
+    base::OnceTaskRefptr<base::closure> task;
+    ParallelReduceTimings* timings;
+  };
+
+  Poster poster_;
+  std::vector<Entry> entries_;
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(ParallelReduceExecutor);
+};
+
+}  // namespace tasm
+}  // namespace lynx
+
+#endif  // CORE_RENDERER_DOM_PARALLEL_REDUCE_EXECUTOR_H_
@@ -0,0 +1,199 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_SHARED_WORKER_POOL_H_
+#define BASE_INCLUDE_FML_SHARED_WORKER_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "base/include/closure.h"
+#include "base/include/fml/concurrent_message_loop.h"
+#include "base/include/fml/macros.h"
+
+namespace lynx {
+namespace fml {
+
+enum class WorkerPriority : int32_t {
+  // The caller waits for the result, e.g. the parallel flush of elements.
+  kUserBlocking = 0,
+  // Needed for the next frames, e.g. decoding.
+  kUserVisible,
+  // May be deferred, e.g. preloading or code cache generation.
+  kBackground,
+};
+
+struct SharedWorkerPoolStats {
+  static constexpr size_t kPriorityCount = 3;
+
+  uint64_t task_count[kPriorityCount] = {};
+  size_t pending_count[kPriorityCount] = {};
+  size_t running_count = 0;
+  size_t max_running_count = 0;
+};
+
+/**
+ * Worker pool shared by the Lynx background work of several clients, so that
+ * they do not each bring their own threads and oversubscribe the cores on busy
+ * devices.
+ *
+ * Tasks are queued per priority and run on an underlying ConcurrentMessageLoop
+ * by at most |max_concurrency| workers at a time, across all priorities and all
+ * clients. A free worker always takes the most urgent task first, and
+ * background tasks never occupy more than |max_background_concurrency| workers,
+ * so that the other workers stay available to the more urgent tasks. Running
+ * tasks are never preempted though: once user visible tasks occupy every
+ * worker, a blocking task waits for one of them to finish.
+ *
+ * A worker is a task of the underlying loop which drains the queues and
+ * returns when nothing runnable is left, it never blocks a thread of the loop.
+ */
+class SharedWorkerPool : public std::enable_shared_from_this<SharedWorkerPool> {
+ public:
+  using Poster = base::MoveOnlyClosure<void, base::closure>;
+
+  // |poster| runs a worker on some thread, typically
+  // ConcurrentMessageLoop::PostTask. Zero |max_background_concurrency| means
+  // half of |max_concurrency|, rounded up.
+  static std::shared_ptr<SharedWorkerPool> Create(
+      Poster poster, size_t max_concurrency,
+      size_t max_background_concurrency = 0) {
+    return std::shared_ptr<SharedWorkerPool>(new SharedWorkerPool(
+        std::move(poster), max_concurrency, max_background_concurrency));
+  }
+
+  static std::shared_ptr<SharedWorkerPool> Create(
+      std::shared_ptr<ConcurrentMessageLoop> loop,
+      size_t max_background_concurrency = 0) {
+    const size_t max_concurrency = loop->GetWorkerCount();
+    return Create([loop = std::move(loop)](
+                      base::closure task) { loop->PostTask(std::move(task)); },
+                  max_concurrency, max_background_concurrency);
+  }
+
+  size_t GetMaxConcurrency() const { return max_concurrency_; }
+
+  void PostTask(WorkerPriority priority, base::closure task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queues_[Index(priority)].push_back(std::move(task));
+      ++stats_.task_count[Index(priority)];
+      if (!ShouldStartWorkerLocked()) {
+        return;
+      }
+      ++running_;
+      stats_.max_running_count = std::max(stats_.max_running_count, running_);
+    }
+    poster_([self = shared_from_this()]() { self->RunWorker(); });
+  }
+
+  SharedWorkerPoolStats GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SharedWorkerPoolStats stats = stats_;
+    for (size_t i = 0; i < kPriorityCount; ++i) {
+      stats.pending_count[i] = queues_[i].size();
+    }
+    stats.running_count = running_;
+    return stats;
+  }
+
+ private:
+  static constexpr size_t kPriorityCount =
+      SharedWorkerPoolStats::kPriorityCount;
+  static constexpr size_t kBackground =
+      static_cast<size_t>(WorkerPriority::kBackground);
+
+  SharedWorkerPool(Poster poster, size_t max_concurrency,
+                   size_t max_background_concurrency)
+      : poster_(std::move(poster)),
+        max_concurrency_(std::max<size_t>(max_concurrency, 1)),
+        max_background_concurrency_(
+            max_background_concurrency != 0
+                ? std::min(max_background_concurrency, max_concurrency_)
+                : (max_concurrency_ + 1) / 2) {}
+
+  static size_t Index(WorkerPriority priority) {
+    return static_cast<size_t>(priority);
+  }
+
+  // Whether a new worker would find a task it may run.
+  bool ShouldStartWorkerLocked() const {
+    if (running_ >= max_concurrency_) {
+      return false;
+    }
+    for (size_t i = 0; i < kBackground; ++i) {
+      if (!queues_[i].empty()) {
+        return true;
+      }
+    }
+    return !queues_[kBackground].empty() &&
+           running_background_ < max_background_concurrency_;
+  }
+
+  // Pops the most urgent runnable task, if any.
+  bool PopLocked(base::closure& task, bool& is_background) {
+    for (size_t i = 0; i < kBackground; ++i) {
+      if (!queues_[i].empty()) {
+        task = std::move(queues_[i].front());
+        queues_[i].pop_front();
+        is_background = false;
+        return true;
+      }
+    }
+    if (!queues_[kBackground].empty() &&
+        running_background_ < max_background_concurrency_) {
+      task = std::move(queues_[kBackground].front());
+      queues_[kBackground].pop_front();
+      is_background = true;
+      return true;
+    }
+    return false;
+  }
+
+  void RunWorker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    base::closure task;
+    bool is_background = false;
+    while (PopLocked(task, is_background)) {
+      if (is_background) {
+        ++running_background_;
+      }
+      lock.unlock();
+      task();
+      task = nullptr;
+      lock.lock();
+      if (is_background) {
+        --running_background_;
+      }
+    }
+    --running_;
+  }
+
+  Poster poster_;
+  const size_t max_concurrency_;
+  const size_t max_background_concurrency_;
+
+  mutable std::mutex mutex_;
+  std::deque<base::closure> queues_[kPriorityCount];
+  size_t running_{0};
+  size_t running_background_{0};
+  SharedWorkerPoolStats stats_;
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(SharedWorkerPool);
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::SharedWorkerPool;
+using lynx::fml::WorkerPriority;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_SHARED_WORKER_POOL_H_
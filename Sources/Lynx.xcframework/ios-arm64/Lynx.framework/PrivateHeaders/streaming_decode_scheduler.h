@@ -0,0 +1,131 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_TEMPLATE_BUNDLE_TEMPLATE_CODEC_BINARY_DECODER_STREAMING_DECODE_SCHEDULER_H_
+#define CORE_TEMPLATE_BUNDLE_TEMPLATE_CODEC_BINARY_DECODER_STREAMING_DECODE_SCHEDULER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/include/closure.h"
+#include "core/template_bundle/template_codec/template_binary.h"
+
+namespace lynx {
+namespace tasm {
+
+/**
+ * Runs the decode stages of a template being downloaded in file order, each
+ * as soon as the bytes it needs arrived, see lepus::StreamingInputBuffer.
+ *
+ * A stage is added with the offset its bytes end at, e.g. the end offset of
+ * its section in the section route. The sections needed by the first screen,
+ * i.e. string list, CSS descriptor, page and element templates, are marked as
+ * such: |on_first_screen| is called once they all ran, so that rendering
+ * starts while the lazy sections are still arriving.
+ *
+ * Stages may be added while pumping, like the header stage adding the section
+ * route stage, which adds the section stages. Such stages must not be marked
+ * first screen themselves, otherwise the first screen would be reported before
+ * the stages they add. Not thread safe, pump on the decoding thread whenever
+ * bytes arrived.
+ */
+class StreamingDecodeScheduler {
+ public:
+  enum class Status {
+    // Waiting for more bytes.
+    kWaiting,
+    // All stages ran.
+    kDone,
+    // A stage failed.
+    kError,
+  };
+
+  using Stage = base::MoveOnlyClosure<bool>;
+
+  explicit StreamingDecodeScheduler(base::closure on_first_screen)
+      : on_first_screen_(std::move(on_first_screen)) {}
+
+  StreamingDecodeScheduler(const StreamingDecodeScheduler&) = delete;
+  StreamingDecodeScheduler& operator=(const StreamingDecodeScheduler&) =
+      delete;
+
+  void AddStage(size_t end_offset, Stage stage, bool first_screen) {
+    if (first_screen) {
+      ++pending_first_screen_stages_;
+    }
+    stages_.push_back({end_offset, std::move(stage), first_screen});
+  }
+
+  void AddSectionStage(const TemplateBinary::SectionInfo& section, Stage stage,
+                       bool first_screen) {
+    AddStage(section.end_offset_, std::move(stage), first_screen);
+  }
+
+  // Runs the stages whose bytes are within |available|, in the order they
+  // were added.
+  Status Pump(size_t available) {
+    if (status_ == Status::kError) {
+      return status_;
+    }
+    while (next_ < stages_.size() && stages_[next_].end_offset <= available) {
+      // The stage may add stages, which can reallocate |stages_|.
+      Stage stage = std::move(stages_[next_].stage);
+      const bool first_screen = stages_[next_].first_screen;
+      ++next_;
+      if (!stage()) {
+        status_ = Status::kError;
+        return status_;
+      }
+      if (first_screen && --pending_first_screen_stages_ == 0) {
+        NotifyFirstScreen();
+      }
+    }
+    if (next_ < stages_.size()) {
+      status_ = Status::kWaiting;
+      return status_;
+    }
+    // Templates without any first screen stage render once fully decoded.
+    NotifyFirstScreen();
+    status_ = Status::kDone;
+    return status_;
+  }
+
+  // The offset the next stage waits for, or 0 if none.
+  size_t NextRequiredSize() const {
+    return next_ < stages_.size() ? stages_[next_].end_offset : 0;
+  }
+
+  bool HasReachedFirstScreen() const { return first_screen_notified_; }
+
+ private:
+  struct Entry {
+    size_t end_offset;
+    Stage stage;
+    bool first_screen;
+  };
+
+  void NotifyFirstScreen() {
+    if (first_screen_notified_) {
+      return;
+    }
+    first_screen_notified_ = true;
+    if (on_first_screen_) {
+      on_first_screen_();
+    }
+  }
+
+  std::vector<Entry> stages_;
+  size_t next_{0};
+  uint32_t pending_first_screen_stages_{0};
+  base::closure on_first_screen_;
+  bool first_screen_notified_{false};
+  Status status_{Status::kWaiting};
+};
+
+}  // namespace tasm
+}  // namespace lynx
+
+#endif  // CORE_TEMPLATE_BUNDLE_TEMPLATE_CODEC_BINARY_DECODER_STREAMING_DECODE_SCHEDULER_H_
@@ -0,0 +1,146 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_RUNTIME_VM_LEPUS_STREAMING_INPUT_STREAM_H_
+#define CORE_RUNTIME_VM_LEPUS_STREAMING_INPUT_STREAM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "core/runtime/vm/lepus/binary_input_stream.h"
+
+namespace lynx {
+namespace lepus {
+
+/**
+ * Buffer of a template being downloaded, filled by the loader while the
+ * decoder already reads the bytes which arrived.
+ *
+ * The whole buffer is allocated upfront from the expected size, the total
+ * size field of the template header or the content length, so that the
+ * pointers handed out by the streams never move. Append() may be called from
+ * any thread, the readers see the bytes once Append() returns.
+ */
+class StreamingInputBuffer {
+ public:
+  explicit StreamingInputBuffer(size_t expected_size)
+      : data_(new uint8_t[std::max<size_t>(expected_size, 1)]),
+        capacity_(expected_size) {}
+
+  StreamingInputBuffer(const StreamingInputBuffer&) = delete;
+  StreamingInputBuffer& operator=(const StreamingInputBuffer&) = delete;
+
+  // Returns false if the bytes exceed the expected size, in which case the
+  // buffer fails.
+  bool Append(const uint8_t* data, size_t len) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t available = available_.load(std::memory_order_relaxed);
+    if (state_ != State::kLoading || len > capacity_ - available) {
+      state_ = State::kFailed;
+      condition_.notify_all();
+      return false;
+    }
+    memcpy(data_.get() + available, data, len);
+    available_.store(available + len, std::memory_order_release);
+    condition_.notify_all();
+    return true;
+  }
+
+  // Called by the loader when the download ends, |success| is false if it
+  // failed or fewer bytes than expected arrived.
+  void Finish(bool success) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == State::kLoading) {
+      state_ = success && available_.load(std::memory_order_relaxed) ==
+                              capacity_
+                   ? State::kComplete
+                   : State::kFailed;
+    }
+    condition_.notify_all();
+  }
+
+  // Blocks until |size| bytes arrived. Returns false if they never will.
+  bool WaitFor(size_t size) {
+    if (size <= available()) {
+      return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this, size]() {
+      return size <= available_.load(std::memory_order_relaxed) ||
+             state_ != State::kLoading;
+    });
+    return size <= available_.load(std::memory_order_relaxed);
+  }
+
+  uint8_t* data() { return data_.get(); }
+  size_t capacity() const { return capacity_; }
+  size_t available() const {
+    return available_.load(std::memory_order_acquire);
+  }
+
+  bool IsComplete() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_ == State::kComplete;
+  }
+
+  bool IsFailed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_ == State::kFailed;
+  }
+
+ private:
+  enum class State { kLoading, kComplete, kFailed };
+
+  std::unique_ptr<uint8_t[]> data_;
+  const size_t capacity_;
+  std::atomic<size_t> available_{0};
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  State state_{State::kLoading};
+};
+
+/**
+ * InputStream over the bytes of a StreamingInputBuffer which arrived so far:
+ * reading beyond them fails like reading beyond the end of a complete buffer,
+ * and succeeds once they arrive. Derived streams share the buffer.
+ *
+ * size() is the expected size of the template while end() follows the bytes
+ * which arrived, so Seek() lands on a section which did not arrive yet, and
+ * the reads there fail in CheckSize() until it does.
+ */
+class StreamingInputStream : public InputStream {
+ public:
+  explicit StreamingInputStream(std::shared_ptr<StreamingInputBuffer> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  StreamingInputStream(const StreamingInputStream&) = delete;
+  StreamingInputStream& operator=(const StreamingInputStream&) = delete;
+
+  const std::shared_ptr<StreamingInputBuffer>& buffer() const {
+    return buffer_;
+  }
+
+  uint8_t* begin() override { return buffer_->data(); }
+  uint8_t* end() override { return buffer_->data() + buffer_->available(); }
+  size_t size() override { return buffer_->capacity(); }
+
+  std::unique_ptr<InputStream> DeriveInputStream() override {
+    return std::make_unique<StreamingInputStream>(buffer_);
+  }
+
+ private:
+  std::shared_ptr<StreamingInputBuffer> buffer_;
+};
+
+}  // namespace lepus
+}  // namespace lynx
+
+#endif  // CORE_RUNTIME_VM_LEPUS_STREAMING_INPUT_STREAM_H_
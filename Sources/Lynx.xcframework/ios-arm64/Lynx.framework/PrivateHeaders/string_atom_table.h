@@ -0,0 +1,207 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_VALUE_STRING_ATOM_TABLE_H_
+#define BASE_INCLUDE_VALUE_STRING_ATOM_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/include/value/base_string.h"
+
+namespace lynx {
+namespace base {
+
+/// Process wide table of canonical strings (atoms).
+///
+/// Intern() returns the unique atom for a content, so that two interned
+/// Strings with the same content share one RefCountedStringImpl. Atom identity
+/// is only known to the table, RefCountedStringImpl and String are untouched:
+/// use AtomString where equality should be a pointer comparison. Atoms are
+/// immortal: the table holds a reference forever and the returned String does
+/// not retain it.
+///
+/// Entries are keyed by String::hash(), the hash computed by the String
+/// constructor, so that a String and its atom always land on the same probe
+/// sequence.
+///
+/// Lookups are lock free: the table is an open addressing array of atomic impl
+/// pointers which only ever gains entries. Inserts take a mutex; on growth the
+/// old array is kept alive for readers still probing it.
+///
+/// Interning is opt-in. It pays off for small, highly repeated vocabularies
+/// such as class names, tag names and attribute keys from the template string
+/// section, not for arbitrary data.
+class AtomTable {
+ public:
+  static String Intern(const String& str) {
+    if (str.empty()) {
+      return String();
+    }
+    return Instance().FindOrInsert(str);
+  }
+
+  // Builds a String first, its constructor computes the hash the table is
+  // keyed by.
+  static String Intern(std::string_view str) {
+    if (str.empty()) {
+      return String();
+    }
+    return Intern(String(str.data(), str.size()));
+  }
+
+  static String Intern(const char* str) {
+    return Intern(std::string_view(str));
+  }
+
+  static bool IsAtom(const String& str) {
+    auto* impl = String::Unsafe::GetUntaggedStringRawRef(str);
+    if (impl->empty()) {
+      return false;
+    }
+    const Slots& slots = *Instance().slots_.load(std::memory_order_acquire);
+    return Find(slots, str.string_view(), str.hash()) == impl;
+  }
+
+  static size_t size() {
+    auto& instance = Instance();
+    std::lock_guard<std::mutex> lock(instance.mutex_);
+    return instance.count_;
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 1024;
+
+  struct Slots {
+    explicit Slots(size_t capacity)
+        : mask(capacity - 1),
+          entries(new std::atomic<RefCountedStringImpl*>[capacity]) {
+      for (size_t i = 0; i < capacity; ++i) {
+        entries[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    const size_t mask;
+    std::unique_ptr<std::atomic<RefCountedStringImpl*>[]> entries;
+  };
+
+  AtomTable() {
+    slots_list_.emplace_back(std::make_unique<Slots>(kInitialCapacity));
+    slots_.store(slots_list_.back().get(), std::memory_order_release);
+  }
+
+  static AtomTable& Instance() {
+    // Intentionally leaked, atoms must outlive every String.
+    static AtomTable* instance = new AtomTable();
+    return *instance;
+  }
+
+  static RefCountedStringImpl* Find(const Slots& slots, std::string_view str,
+                                    size_t hash) {
+    for (size_t i = hash & slots.mask;; i = (i + 1) & slots.mask) {
+      RefCountedStringImpl* impl =
+          slots.entries[i].load(std::memory_order_acquire);
+      if (impl == nullptr) {
+        return nullptr;
+      }
+      if (impl->hash() == hash && impl->str() == str) {
+        return impl;
+      }
+    }
+  }
+
+  static void Insert(Slots& slots, RefCountedStringImpl* impl) {
+    size_t i = impl->hash() & slots.mask;
+    while (slots.entries[i].load(std::memory_order_relaxed) != nullptr) {
+      i = (i + 1) & slots.mask;
+    }
+    slots.entries[i].store(impl, std::memory_order_release);
+  }
+
+  String FindOrInsert(const String& str) {
+    const std::string_view content = str.string_view();
+    const size_t hash = str.hash();
+    if (auto* impl =
+            Find(*slots_.load(std::memory_order_acquire), content, hash)) {
+      return String::Unsafe::ConstructWeakRefStringFromRawRef(impl);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slots* slots = slots_.load(std::memory_order_relaxed);
+    if (auto* impl = Find(*slots, content, hash)) {
+      return String::Unsafe::ConstructWeakRefStringFromRawRef(impl);
+    }
+    // Keep the load factor at most 1/2 so that probe sequences stay short.
+    if ((count_ + 1) * 2 > slots->mask + 1) {
+      slots_list_.emplace_back(std::make_unique<Slots>((slots->mask + 1) * 2));
+      Slots* grown = slots_list_.back().get();
+      for (size_t i = 0; i <= slots->mask; ++i) {
+        if (auto* impl = slots->entries[i].load(std::memory_order_relaxed)) {
+          Insert(*grown, impl);
+        }
+      }
+      slots_.store(grown, std::memory_order_release);
+      slots = grown;
+    }
+    // A private copy, |str| may be a static or a caller owned impl. The table
+    // owns its initial reference, which is never released.
+    RefCountedStringImpl* impl =
+        RefCountedStringImpl::Unsafe::RawCreate(str.str());
+    Insert(*slots, impl);
+    ++count_;
+    return String::Unsafe::ConstructWeakRefStringFromRawRef(impl);
+  }
+
+  std::atomic<Slots*> slots_{nullptr};
+  std::mutex mutex_;
+  // Every generation is retained, readers may still probe an old one.
+  std::vector<std::unique_ptr<Slots>> slots_list_;
+  size_t count_{0};
+};
+
+/// String interned in AtomTable. Equality and hashing are those of the atom
+/// pointer, so AtomStrings compare in constant time whatever their length.
+/// Converts back to a String sharing the atom.
+class AtomString {
+ public:
+  AtomString() = default;
+  explicit AtomString(const String& str) : str_(AtomTable::Intern(str)) {}
+  explicit AtomString(std::string_view str) : str_(AtomTable::Intern(str)) {}
+
+  const String& str() const { return str_; }
+  std::string_view string_view() const { return str_.string_view(); }
+  bool empty() const { return str_.empty(); }
+  std::size_t hash() const { return str_.hash(); }
+
+  bool operator==(const AtomString& other) const {
+    return impl() == other.impl();
+  }
+  bool operator!=(const AtomString& other) const {
+    return impl() != other.impl();
+  }
+
+  struct Hash {
+    std::size_t operator()(const AtomString& str) const {
+      return std::hash<const void*>()(str.impl());
+    }
+  };
+
+ private:
+  const RefCountedStringImpl* impl() const {
+    return String::Unsafe::GetUntaggedStringRawRef(str_);
+  }
+
+  String str_;
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_VALUE_STRING_ATOM_TABLE_H_
@@ -0,0 +1,132 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_TASK_LATENCY_HISTOGRAM_H_
+#define BASE_INCLUDE_FML_TASK_LATENCY_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "base/include/fml/macros.h"
+#include "base/include/fml/task_source_grade.h"
+#include "base/include/fml/time/time_delta.h"
+
+namespace lynx {
+namespace fml {
+
+/**
+ * Per TaskSourceGrade histograms of queue latency, i.e. the time between the
+ * moment a task became runnable (its target time) and the moment it was
+ * popped to run.
+ *
+ * Buckets are powers of two of microseconds: bucket 0 holds latencies below
+ * 1us, bucket i holds [2^(i-1), 2^i) us and the last bucket everything above.
+ * Record() is a few relaxed atomic increments, so it may be called from any
+ * thread right before a task runs, e.g. by a runner wrapping its tasks.
+ */
+class TaskLatencyHistogram {
+ public:
+  static constexpr size_t kBucketCount = 24;
+  static constexpr size_t kGradeCount =
+      static_cast<size_t>(TaskSourceGrade::kIdle) + 1;
+
+  struct Snapshot {
+    std::array<uint64_t, kBucketCount> buckets{};
+    uint64_t count = 0;
+    uint64_t total_micros = 0;
+    uint64_t max_micros = 0;
+
+    // Upper bound in microseconds of the bucket holding the given percentile,
+    // |percentile| in [0, 100].
+    uint64_t PercentileUpperBoundMicros(double percentile) const {
+      if (count == 0) {
+        return 0;
+      }
+      const double rank = count * percentile / 100.0;
+      uint64_t seen = 0;
+      for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0) {
+          return i + 1 < kBucketCount ? BucketUpperBoundMicros(i) : max_micros;
+        }
+      }
+      return max_micros;
+    }
+  };
+
+  TaskLatencyHistogram() = default;
+
+  void Record(TaskSourceGrade grade, TimeDelta latency) {
+    const int64_t micros = latency.ToMicroseconds();
+    const uint64_t value = micros > 0 ? static_cast<uint64_t>(micros) : 0;
+    Grade& g = grades_[static_cast<size_t>(grade)];
+    g.buckets[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    g.count.fetch_add(1, std::memory_order_relaxed);
+    g.total_micros.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = g.max_micros.load(std::memory_order_relaxed);
+    while (value > max && !g.max_micros.compare_exchange_weak(
+                              max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Not an atomic snapshot while tasks are being recorded, each counter is.
+  Snapshot GetSnapshot(TaskSourceGrade grade) const {
+    const Grade& g = grades_[static_cast<size_t>(grade)];
+    Snapshot snapshot;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      snapshot.buckets[i] = g.buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count = g.count.load(std::memory_order_relaxed);
+    snapshot.total_micros = g.total_micros.load(std::memory_order_relaxed);
+    snapshot.max_micros = g.max_micros.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  void Reset() {
+    for (Grade& g : grades_) {
+      for (auto& bucket : g.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+      g.count.store(0, std::memory_order_relaxed);
+      g.total_micros.store(0, std::memory_order_relaxed);
+      g.max_micros.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  static uint64_t BucketUpperBoundMicros(size_t bucket) {
+    return uint64_t(1) << bucket;
+  }
+
+ private:
+  struct Grade {
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_micros{0};
+    std::atomic<uint64_t> max_micros{0};
+  };
+
+  static size_t BucketOf(uint64_t micros) {
+    size_t bucket = 0;
+    while (micros != 0 && bucket + 1 < kBucketCount) {
+      micros >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  std::array<Grade, kGradeCount> grades_;
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskLatencyHistogram);
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::TaskLatencyHistogram;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_TASK_LATENCY_HISTOGRAM_H_
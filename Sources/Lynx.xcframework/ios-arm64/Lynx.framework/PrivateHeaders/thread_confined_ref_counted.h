@@ -0,0 +1,92 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_MEMORY_THREAD_CONFINED_REF_COUNTED_H_
+#define BASE_INCLUDE_FML_MEMORY_THREAD_CONFINED_REF_COUNTED_H_
+
+#include <cstdint>
+#include <thread>
+
+#include "base/include/fml/macros.h"
+#include "base/include/fml/memory/ref_ptr.h"
+
+namespace lynx {
+namespace fml {
+
+// A base class for reference-counted classes whose objects, and every RefPtr
+// to them, never leave the thread that created them, e.g. temporaries built
+// and dropped within one TASM pass. The count is a plain integer, so AddRef()
+// and Release() cost no atomic read-modify-write. Debug builds check that
+// both are called on the creating thread. Use like
+// RefCountedThreadSafe:
+//
+//   class Foo : public ThreadConfinedRefCounted<Foo> {
+//     ...
+//   };
+//
+//   auto foo = MakeRefCounted<Foo>();
+//
+// It is a separate base rather than a mode of RefCountedThreadSafe, whose
+// encoding is shared with code compiled into the Lynx binary. An object can
+// not switch between the two: data to be handed to another thread must be
+// copied into a RefCountedThreadSafe object.
+//
+// The creating thread is recorded in every build, so the layout does not
+// depend on NDEBUG.
+template <typename T>
+class ThreadConfinedRefCounted {
+ public:
+  void AddRef() const {
+    LYNX_BASE_DCHECK(thread_id_ == std::this_thread::get_id());
+    ++ref_count_;
+  }
+
+  // Releases a reference to this object. This will destroy this object once the
+  // last reference is released.
+  void Release() const {
+    LYNX_BASE_DCHECK(thread_id_ == std::this_thread::get_id());
+    LYNX_BASE_DCHECK(ref_count_ != 0u);
+    if (--ref_count_ == 0u) {
+      delete static_cast<const T*>(this);
+    }
+  }
+
+  bool HasOneRef() const { return ref_count_ == 1u; }
+
+  void AssertHasOneRef() const { LYNX_BASE_DCHECK(HasOneRef()); }
+
+  // Returns the current reference count. Should be used only for debugging.
+  int SubtleRefCountForDebug() const { return static_cast<int>(ref_count_); }
+
+ protected:
+  // Constructed with a reference count of 1, which must be adopted (see
+  // |AdoptRef()| in ref_ptr.h).
+  ThreadConfinedRefCounted() = default;
+  ~ThreadConfinedRefCounted() = default;
+
+ private:
+  template <typename U>
+  friend RefPtr<U> AdoptRef(U*);
+  // Called by |AdoptRef()| in Debug builds, nothing to mark here.
+  void Adopt() {}
+
+  mutable uint32_t ref_count_{1u};
+  const std::thread::id thread_id_{std::this_thread::get_id()};
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(ThreadConfinedRefCounted);
+};
+
+// If you subclass |ThreadConfinedRefCounted| and want to keep your destructor
+// private, use this.
+#define FML_FRIEND_THREAD_CONFINED_REF_COUNTED(T) \
+  friend class lynx::fml::ThreadConfinedRefCounted<T>
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::ThreadConfinedRefCounted;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_MEMORY_THREAD_CONFINED_REF_COUNTED_H_
@@ -0,0 +1,426 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_TIME_TIMER_WHEEL_H_
+#define BASE_INCLUDE_FML_TIME_TIMER_WHEEL_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/include/closure.h"
+#include "base/include/fml/macros.h"
+#include "base/include/fml/memory/weak_ptr.h"
+#include "base/include/fml/task_runner.h"
+#include "base/include/fml/time/time_delta.h"
+#include "base/include/fml/time/time_point.h"
+
+namespace lynx {
+namespace fml {
+
+/**
+ * Hierarchical timer wheel counting in abstract ticks: kLevels wheels of
+ * kSlots slots, each level covering kSlots times the span of the one below.
+ * A timer is linked into the slot of the coarsest level it does not outgrow
+ * and moves down a level each time that slot comes around, so that Start()
+ * and Stop() are O(1) and AdvanceTo() touches each timer at most kLevels
+ * times, jumping over empty slots with the per level occupancy bitmaps.
+ *
+ * Timers expire in the order of their slots, those sharing a tick in no
+ * particular order. A timer beyond the range of the wheel, kMaxDelayTicks, is
+ * parked at its end and relinked from there. Not thread safe; the tasks may
+ * start and stop timers, including their own.
+ */
+class TimerWheel {
+ public:
+  using TimerId = uint64_t;
+
+  static constexpr TimerId kInvalidTimerId = 0;
+  static constexpr size_t kLevels = 4;
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlots = size_t(1) << kSlotBits;
+  static constexpr uint64_t kMaxDelayTicks =
+      (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+  static constexpr uint64_t kNoExpiration =
+      std::numeric_limits<uint64_t>::max();
+
+  explicit TimerWheel(uint64_t now_tick = 0) : now_(now_tick) {
+    for (auto& level : heads_) {
+      std::fill(level.begin(), level.end(), kNil);
+    }
+  }
+
+  uint64_t now() const { return now_; }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // Runs |task| after |delay_ticks|, at least 1, and then every
+  // |interval_ticks| if not 0.
+  TimerId Start(base::closure task, uint64_t delay_ticks,
+                uint64_t interval_ticks = 0) {
+    const uint32_t index = AllocateNode();
+    Node& node = nodes_[index];
+    node.task = std::move(task);
+    node.interval = interval_ticks;
+    node.active = true;
+    ++size_;
+    Link(index, now_ + std::max<uint64_t>(delay_ticks, 1));
+    return MakeId(index, node.generation);
+  }
+
+  // Returns false if |id| already expired or was stopped.
+  bool Stop(TimerId id) {
+    const uint32_t index = IndexOf(id);
+    if (index >= nodes_.size() || !nodes_[index].active ||
+        nodes_[index].generation != GenerationOf(id)) {
+      return false;
+    }
+    if (index == running_) {
+      // Freed by AdvanceTo() once its task returns.
+      nodes_[index].active = false;
+      return true;
+    }
+    Unlink(index);
+    FreeNode(index);
+    return true;
+  }
+
+  void StopAll() {
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+      if (nodes_[i].active) {
+        Stop(MakeId(i, nodes_[i].generation));
+      }
+    }
+  }
+
+  // Tick of the next expiration, or kNoExpiration. For timers on the coarse
+  // levels this is the tick at which their slot moves down, which is early
+  // but never late, and AdvanceTo() it simply runs nothing.
+  uint64_t NextExpiration() const {
+    uint64_t next = kNoExpiration;
+    for (size_t level = 0; level < kLevels; ++level) {
+      if (bitmaps_[level] == 0) {
+        continue;
+      }
+      const size_t shift = kSlotBits * level;
+      const uint64_t current = now_ >> shift;
+      // Distance in slots to the next occupied one, never the current one.
+      const size_t from = (current + 1) & kSlotMask;
+      const uint64_t rotated = Rotate(bitmaps_[level], from);
+      const uint64_t distance = CountTrailingZeros(rotated) + 1;
+      next = std::min(next, (current + distance) << shift);
+    }
+    return next;
+  }
+
+  // Runs the tasks of the timers expiring up to |tick| included.
+  void AdvanceTo(uint64_t tick) {
+    while (now_ < tick) {
+      if (size_ == 0) {
+        now_ = tick;
+        return;
+      }
+      uint64_t next = now_ + 1;
+      const size_t slot = next & kSlotMask;
+      if (slot != 0) {
+        // Jumps to the next occupied slot of level 0 or to its wrap around.
+        const uint64_t pending = bitmaps_[0] >> slot;
+        next += pending != 0 ? CountTrailingZeros(pending) : kSlots - slot;
+        if (next > tick) {
+          now_ = tick;
+          return;
+        }
+      }
+      now_ = next;
+      if ((now_ & kSlotMask) == 0) {
+        Cascade(1);
+      }
+      Expire(now_ & kSlotMask);
+    }
+  }
+
+ private:
+  static constexpr uint32_t kNil = std::numeric_limits<uint32_t>::max();
+  static constexpr uint64_t kSlotMask = kSlots - 1;
+
+  struct Node {
+    base::closure task;
+    uint64_t expire = 0;
+    uint64_t interval = 0;
+    uint32_t prev = kNil;
+    uint32_t next = kNil;
+    // Starts at 1 so that no id equals kInvalidTimerId.
+    uint32_t generation = 1;
+    uint8_t level = 0;
+    uint8_t slot = 0;
+    bool active = false;
+  };
+
+  static TimerId MakeId(uint32_t index, uint32_t generation) {
+    return (uint64_t(generation) << 32) | index;
+  }
+  static uint32_t IndexOf(TimerId id) { return static_cast<uint32_t>(id); }
+  static uint32_t GenerationOf(TimerId id) {
+    return static_cast<uint32_t>(id >> 32);
+  }
+
+  static uint64_t Rotate(uint64_t bits, size_t by) {
+    return by == 0 ? bits : (bits >> by) | (bits << (kSlots - by));
+  }
+
+  static size_t CountTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(bits));
+#else
+    size_t count = 0;
+    while ((bits & 1) == 0) {
+      bits >>= 1;
+      ++count;
+    }
+    return count;
+#endif
+  }
+
+  uint32_t AllocateNode() {
+    if (free_ != kNil) {
+      const uint32_t index = free_;
+      free_ = nodes_[index].next;
+      nodes_[index].next = kNil;
+      return index;
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  void FreeNode(uint32_t index) {
+    Node& node = nodes_[index];
+    node.task = nullptr;
+    node.active = false;
+    ++node.generation;
+    if (node.generation == 0) {
+      node.generation = 1;
+    }
+    node.prev = kNil;
+    node.next = free_;
+    free_ = index;
+    --size_;
+  }
+
+  void Link(uint32_t index, uint64_t expire) {
+    Node& node = nodes_[index];
+    node.expire = expire;
+    const uint64_t delta = std::min(expire - now_, kMaxDelayTicks);
+    expire = now_ + delta;
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >> (kSlotBits * (level + 1)) != 0) {
+      ++level;
+    }
+    node.level = static_cast<uint8_t>(level);
+    node.slot =
+        static_cast<uint8_t>((expire >> (kSlotBits * level)) & kSlotMask);
+    uint32_t& head = heads_[level][node.slot];
+    node.prev = kNil;
+    node.next = head;
+    if (head != kNil) {
+      nodes_[head].prev = index;
+    }
+    head = index;
+    bitmaps_[level] |= uint64_t(1) << node.slot;
+  }
+
+  void Unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    uint32_t& head = heads_[node.level][node.slot];
+    if (node.prev != kNil) {
+      nodes_[node.prev].next = node.next;
+    } else {
+      head = node.next;
+    }
+    if (node.next != kNil) {
+      nodes_[node.next].prev = node.prev;
+    }
+    if (head == kNil) {
+      bitmaps_[node.level] &= ~(uint64_t(1) << node.slot);
+    }
+    node.prev = kNil;
+    node.next = kNil;
+  }
+
+  // Relinks the timers of the slot of |level| starting at now_, which all
+  // expire within its span and so land on lower levels. Timers due now land
+  // in the current slot of level 0, which Expire() runs next.
+  void Cascade(size_t level) {
+    if (level >= kLevels) {
+      return;
+    }
+    const size_t slot = (now_ >> (kSlotBits * level)) & kSlotMask;
+    if (slot == 0) {
+      Cascade(level + 1);
+    }
+    uint32_t index = heads_[level][slot];
+    heads_[level][slot] = kNil;
+    bitmaps_[level] &= ~(uint64_t(1) << slot);
+    while (index != kNil) {
+      const uint32_t next = nodes_[index].next;
+      Link(index, nodes_[index].expire);
+      index = next;
+    }
+  }
+
+  void Expire(size_t slot) {
+    while (heads_[0][slot] != kNil) {
+      const uint32_t index = heads_[0][slot];
+      Unlink(index);
+      if (nodes_[index].expire > now_) {
+        // Was parked at the end of the wheel.
+        Link(index, nodes_[index].expire);
+        continue;
+      }
+      // The task may start timers and reallocate |nodes_|.
+      base::closure task = std::move(nodes_[index].task);
+      running_ = index;
+      task();
+      running_ = kNil;
+      Node& node = nodes_[index];
+      if (node.active && node.interval != 0) {
+        node.task = std::move(task);
+        Link(index, now_ + node.interval);
+      } else {
+        FreeNode(index);
+      }
+    }
+  }
+
+  uint64_t now_;
+  size_t size_{0};
+  uint32_t free_{kNil};
+  uint32_t running_{kNil};
+  std::vector<Node> nodes_;
+  std::array<std::array<uint32_t, kSlots>, kLevels> heads_;
+  std::array<uint64_t, kLevels> bitmaps_{};
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+/**
+ * TimerWheel driven by a TaskRunner, for the many timers of a page such as
+ * lepus setTimeout/setInterval and animation timers. Instead of a delayed task
+ * per timer, only the next tick at which something expires has a delayed
+ * task, which runs every timer due by then, so expirations are coalesced per
+ * tick and the delayed task heap of the runner stays small.
+ *
+ * Timers fire no earlier than requested and at most one tick later. Must be
+ * used on the thread of the runner only, see ForCurrentThread().
+ */
+class TaskRunnerTimerWheel {
+ public:
+  using TimerId = TimerWheel::TimerId;
+
+  static constexpr TimeDelta kDefaultTick = TimeDelta::FromMilliseconds(1);
+
+  explicit TaskRunnerTimerWheel(fml::RefPtr<fml::TaskRunner> runner,
+                                TimeDelta tick = kDefaultTick)
+      : runner_(std::move(runner)), tick_(tick), origin_(TimePoint::Now()) {}
+
+  // The wheel of the current thread, created on first use with |runner|,
+  // which must run its tasks on the current thread.
+  static TaskRunnerTimerWheel& ForCurrentThread(
+      const fml::RefPtr<fml::TaskRunner>& runner) {
+    static thread_local std::unique_ptr<TaskRunnerTimerWheel> wheel;
+    if (wheel == nullptr) {
+      wheel = std::make_unique<TaskRunnerTimerWheel>(runner);
+    }
+    return *wheel;
+  }
+
+  // Runs |task| after |delay|, then every |interval| if it is positive.
+  TimerId Start(base::closure task, TimeDelta delay,
+                TimeDelta interval = TimeDelta::Zero()) {
+    const uint64_t now = CurrentTick();
+    if (wheel_.empty()) {
+      // Nothing can run, only catches up with the clock.
+      wheel_.AdvanceTo(now);
+    }
+    const uint64_t expire = TicksCeil(TimePoint::Now() - origin_ + delay);
+    const uint64_t interval_ticks =
+        interval > TimeDelta::Zero() ? TicksCeil(interval) : 0;
+    const TimerId id = wheel_.Start(
+        std::move(task), expire > wheel_.now() ? expire - wheel_.now() : 1,
+        interval_ticks);
+    ScheduleWakeUp();
+    return id;
+  }
+
+  bool Stop(TimerId id) { return wheel_.Stop(id); }
+
+  void StopAll() { wheel_.StopAll(); }
+
+  size_t size() const { return wheel_.size(); }
+
+ private:
+  static constexpr uint64_t kNoWakeUp = TimerWheel::kNoExpiration;
+
+  uint64_t CurrentTick() const {
+    return static_cast<uint64_t>((TimePoint::Now() - origin_) / tick_);
+  }
+
+  uint64_t TicksCeil(TimeDelta delta) const {
+    if (delta <= TimeDelta::Zero()) {
+      return 0;
+    }
+    const TimeDelta rounding = tick_ - TimeDelta::FromNanoseconds(1);
+    return static_cast<uint64_t>((delta + rounding) / tick_);
+  }
+
+  void ScheduleWakeUp() {
+    const uint64_t next = wheel_.NextExpiration();
+    if (next == TimerWheel::kNoExpiration || next >= scheduled_tick_) {
+      return;
+    }
+    // An already posted later wake-up stays and runs harmlessly.
+    scheduled_tick_ = next;
+    runner_->PostTaskForTime(
+        [weak = weak_factory_.GetWeakPtr(), next]() {
+          if (weak) {
+            weak->OnWakeUp(next);
+          }
+        },
+        origin_ + tick_ * static_cast<int64_t>(next));
+  }
+
+  void OnWakeUp(uint64_t tick) {
+    if (tick == scheduled_tick_) {
+      scheduled_tick_ = kNoWakeUp;
+    }
+    wheel_.AdvanceTo(CurrentTick());
+    ScheduleWakeUp();
+  }
+
+  fml::RefPtr<fml::TaskRunner> runner_;
+  const TimeDelta tick_;
+  const TimePoint origin_;
+  TimerWheel wheel_;
+  uint64_t scheduled_tick_{kNoWakeUp};
+
+  fml::WeakPtrFactory<TaskRunnerTimerWheel> weak_factory_{this};
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(TaskRunnerTimerWheel);
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::TaskRunnerTimerWheel;
+using lynx::fml::TimerWheel;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_TIME_TIMER_WHEEL_H_
@@ -0,0 +1,175 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_VECTOR_SEARCH_H_
+#define BASE_INCLUDE_VECTOR_SEARCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BASE_VECTOR_SEARCH_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BASE_VECTOR_SEARCH_SSE2 1
+#endif
+
+namespace lynx {
+namespace base {
+
+/**
+ * Search kernels used by LinearSearchArray and BinarySearchArray of vector.h
+ * for integral and enum keys.
+ *
+ * FindKey() scans keys laid out with a fixed stride. When keys are contiguous
+ * (sets) it compares 16 bytes at a time with SSE2 or NEON and extracts the
+ * first match from a movemask. For maps, keys are interleaved with values and
+ * the scan is unrolled by four so that it branches once per group.
+ *
+ * LowerBound() is a branchless binary search: the loop trip count only
+ * depends on the size and each step is a conditional move, so it does not
+ * suffer from branch mispredictions on random lookups.
+ */
+namespace vector_search {
+
+template <class K>
+inline constexpr bool kIsVectorizableKey =
+    (std::is_integral_v<K> || std::is_enum_v<K>) &&
+    (sizeof(K) == 1 || sizeof(K) == 2 || sizeof(K) == 4 || sizeof(K) == 8);
+
+template <class K>
+using KeyBits = std::conditional_t<
+    sizeof(K) == 1, uint8_t,
+    std::conditional_t<sizeof(K) == 2, uint16_t,
+                       std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>>>;
+
+template <class K>
+inline KeyBits<K> LoadKeyBits(const char* p) {
+  KeyBits<K> bits;
+  std::memcpy(&bits, p, sizeof(bits));
+  return bits;
+}
+
+template <class K>
+inline KeyBits<K> ToKeyBits(const K& key) {
+  KeyBits<K> bits;
+  std::memcpy(&bits, &key, sizeof(bits));
+  return bits;
+}
+
+#if defined(BASE_VECTOR_SEARCH_NEON) || defined(BASE_VECTOR_SEARCH_SSE2)
+// Returns a mask with one bit (SSE2) or four bits (NEON) per byte set for the
+// bytes of the 16 byte block at |p| whose lanes equal |key|.
+template <class K>
+inline uint64_t MatchMask16(const char* p, KeyBits<K> key) {
+#if defined(BASE_VECTOR_SEARCH_NEON)
+  uint8x16_t eq;
+  if constexpr (sizeof(K) == 1) {
+    eq = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p)),
+                  vdupq_n_u8(key));
+  } else if constexpr (sizeof(K) == 2) {
+    eq = vreinterpretq_u8_u16(vceqq_u16(
+        vld1q_u16(reinterpret_cast<const uint16_t*>(p)), vdupq_n_u16(key)));
+  } else if constexpr (sizeof(K) == 4) {
+    eq = vreinterpretq_u8_u32(vceqq_u32(
+        vld1q_u32(reinterpret_cast<const uint32_t*>(p)), vdupq_n_u32(key)));
+  } else {
+    eq = vreinterpretq_u8_u64(vceqq_u64(
+        vld1q_u64(reinterpret_cast<const uint64_t*>(p)), vdupq_n_u64(key)));
+  }
+  // Narrowing shift packs the 16 byte mask into 64 bits, 4 bits per byte.
+  return vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+#else
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  if constexpr (sizeof(K) == 1) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(key)))));
+  } else if constexpr (sizeof(K) == 2) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(key)))));
+  } else if constexpr (sizeof(K) == 4) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi32(block, _mm_set1_epi32(static_cast<int>(key)))));
+  } else {
+    // SSE2 has no 64 bit compare, a lane matches if both halves match.
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi32(block, _mm_set1_epi64x(static_cast<int64_t>(key)))));
+    return ((mask & 0x00FFu) == 0x00FFu ? 0x00FFu : 0u) |
+           ((mask & 0xFF00u) == 0xFF00u ? 0xFF00u : 0u);
+  }
+#endif
+}
+
+inline size_t FirstMatchedByte(uint64_t mask) {
+#if defined(BASE_VECTOR_SEARCH_NEON)
+  return static_cast<size_t>(__builtin_ctzll(mask)) >> 2;
+#else
+  return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+}
+#endif
+
+/// @return Index of the first key equal to |key| among |count| keys starting
+/// at |base| and |stride| bytes apart, or |count| if absent.
+template <class K>
+inline size_t FindKey(const char* base, size_t stride, size_t count,
+                      const K& key) {
+  static_assert(kIsVectorizableKey<K>);
+  const KeyBits<K> needle = ToKeyBits(key);
+  size_t i = 0;
+#if defined(BASE_VECTOR_SEARCH_NEON) || defined(BASE_VECTOR_SEARCH_SSE2)
+  if (stride == sizeof(K)) {
+    constexpr size_t kLanes = 16 / sizeof(K);
+    for (; i + kLanes <= count; i += kLanes) {
+      if (uint64_t mask = MatchMask16<K>(base + i * sizeof(K), needle)) {
+        return i + FirstMatchedByte(mask) / sizeof(K);
+      }
+    }
+  }
+#endif
+  for (; i + 4 <= count; i += 4) {
+    const char* p = base + i * stride;
+    const bool m0 = LoadKeyBits<K>(p) == needle;
+    const bool m1 = LoadKeyBits<K>(p + stride) == needle;
+    const bool m2 = LoadKeyBits<K>(p + 2 * stride) == needle;
+    const bool m3 = LoadKeyBits<K>(p + 3 * stride) == needle;
+    if (m0 | m1 | m2 | m3) {
+      return i + (m0 ? 0 : m1 ? 1 : m2 ? 2 : 3);
+    }
+  }
+  for (; i < count; ++i) {
+    if (LoadKeyBits<K>(base + i * stride) == needle) {
+      return i;
+    }
+  }
+  return count;
+}
+
+/// Branchless equivalent of std::lower_bound over [first, first + count).
+/// |less(item, key)| must return true if |item| orders before |key|.
+template <class Iterator, class Key, class Less>
+inline Iterator LowerBound(Iterator first, size_t count, const Key& key,
+                           Less less) {
+  if (count == 0) {
+    return first;
+  }
+  while (count > 1) {
+    const size_t half = count / 2;
+    // Compiles to a conditional move, no data dependent branch.
+    first = less(first[half - 1], key) ? first + half : first;
+    count -= half;
+  }
+  return less(*first, key) ? first + 1 : first;
+}
+
+}  // namespace vector_search
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_VECTOR_SEARCH_H_
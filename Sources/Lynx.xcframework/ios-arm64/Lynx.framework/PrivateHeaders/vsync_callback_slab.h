@@ -0,0 +1,329 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_BASE_THREADING_VSYNC_CALLBACK_SLAB_H_
+#define CORE_BASE_THREADING_VSYNC_CALLBACK_SLAB_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+#include "base/include/fml/macros.h"
+
+namespace lynx {
+namespace base {
+
+struct VSyncDispatchStats {
+  uint64_t frame_count = 0;
+  uint64_t callback_count = 0;
+  // From the frame start time to the start of the dispatch.
+  int64_t total_latency_ns = 0;
+  int64_t max_latency_ns = 0;
+};
+
+/**
+ * Registry of one shot vsync callbacks keyed by id, a lock-free alternative to
+ * the map of VSyncMonitor for dispatchers with many secondary callbacks per
+ * frame. Schedule() and Cancel() may be called from any thread; Dispatch()
+ * runs on the thread owning the slab.
+ *
+ * Each slot is a small state machine (free, writing, ready, taking) tagged
+ * with a generation, so a handle to a dispatched or cancelled callback is
+ * rejected instead of hitting a reused slot. An occupancy bitmap lets
+ * Dispatch() visit only the occupied slots.
+ *
+ * Once the |Capacity| slots are taken, further callbacks go to an overflow
+ * map guarded by a mutex, which Dispatch() only locks when it is not empty.
+ * No callback is dropped, only the fast path is bounded.
+ *
+ * Like the map, a callback scheduled for an id replaces the pending one of
+ * that id, provided one id is not scheduled from two threads at the same
+ * time.
+ */
+template <typename Callback, size_t Capacity = 64>
+class VSyncCallbackSlab {
+  static_assert(Capacity > 0 && Capacity <= 64,
+                "The occupancy bitmap is a single word.");
+
+ public:
+  using Handle = uint64_t;
+
+  static constexpr Handle kInvalidHandle = 0;
+
+  VSyncCallbackSlab() = default;
+
+  ~VSyncCallbackSlab() {
+    for (size_t i = 0; i < Capacity; ++i) {
+      if (PhaseOf(slots_[i].state.load(std::memory_order_relaxed)) != kFree) {
+        slots_[i].callback().~Callback();
+      }
+    }
+  }
+
+  Handle Schedule(uintptr_t id, Callback callback) {
+    // Replaces the pending callback of |id| if any.
+    uint64_t occupied = occupied_.load(std::memory_order_acquire);
+    while (occupied != 0) {
+      const size_t index = CountTrailingZeros(occupied);
+      occupied &= occupied - 1;
+      Slot& slot = slots_[index];
+      uint32_t state = slot.state.load(std::memory_order_acquire);
+      if (PhaseOf(state) != kReady ||
+          slot.id.load(std::memory_order_relaxed) != id ||
+          !slot.state.compare_exchange_strong(
+              state, WithPhase(state, kWriting), std::memory_order_acquire)) {
+        continue;
+      }
+      slot.callback() = std::move(callback);
+      slot.state.store(WithPhase(state, kReady), std::memory_order_release);
+      return MakeHandle(index, GenerationOf(state));
+    }
+    if (has_overflow_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(overflow_mutex_);
+      auto it = overflow_.find(id);
+      if (it != overflow_.end()) {
+        it->second.callback = std::move(callback);
+        return MakeHandle(kOverflowIndex, it->second.sequence);
+      }
+    }
+
+    for (size_t index = 0; index < Capacity; ++index) {
+      Slot& slot = slots_[index];
+      uint32_t state = slot.state.load(std::memory_order_relaxed);
+      if (PhaseOf(state) != kFree ||
+          !slot.state.compare_exchange_strong(
+              state, WithPhase(state, kWriting), std::memory_order_acquire)) {
+        continue;
+      }
+      slot.id.store(id, std::memory_order_relaxed);
+      new (slot.storage) Callback(std::move(callback));
+      // Set while still writing: a bit is only cleared in the taking phase,
+      // which this slot cannot reach before it is ready.
+      occupied_.fetch_or(Bit(index), std::memory_order_relaxed);
+      slot.state.store(WithPhase(state, kReady), std::memory_order_release);
+      return MakeHandle(index, GenerationOf(state));
+    }
+    return ScheduleOverflow(id, std::move(callback));
+  }
+
+  // Returns false if the callback already ran or was cancelled.
+  bool Cancel(Handle handle) {
+    const size_t index = IndexOf(handle);
+    if (handle == kInvalidHandle || index > kOverflowIndex) {
+      return false;
+    }
+    if (index == kOverflowIndex) {
+      return CancelOverflow(GenerationOfHandle(handle));
+    }
+    Slot& slot = slots_[index];
+    uint32_t expected = (GenerationOfHandle(handle) << kPhaseBits) | kReady;
+    if (!slot.state.compare_exchange_strong(expected,
+                                            WithPhase(expected, kTaking),
+                                            std::memory_order_acquire)) {
+      return false;
+    }
+    Callback callback = Take(index, expected);
+    (void)callback;
+    return true;
+  }
+
+  // Runs the callbacks ready at the time of the call as
+  // callback(frame_start_time, frame_target_time), times in nanoseconds.
+  // Callbacks scheduled meanwhile, including by the callbacks, wait for the
+  // next frame. |now| is the current time in nanoseconds, for the stats.
+  size_t Dispatch(int64_t frame_start_time, int64_t frame_target_time,
+                  int64_t now) {
+    uint64_t occupied = occupied_.load(std::memory_order_acquire);
+    RecordFrame(now - frame_start_time);
+    size_t count = 0;
+    while (occupied != 0) {
+      const size_t index = CountTrailingZeros(occupied);
+      occupied &= occupied - 1;
+      Slot& slot = slots_[index];
+      uint32_t state = slot.state.load(std::memory_order_acquire);
+      // Skips a slot being replaced, it stays for the next frame.
+      if (PhaseOf(state) != kReady ||
+          !slot.state.compare_exchange_strong(
+              state, WithPhase(state, kTaking), std::memory_order_acquire)) {
+        continue;
+      }
+      Callback callback = Take(index, state);
+      callback(frame_start_time, frame_target_time);
+      ++count;
+    }
+    if (has_overflow_.load(std::memory_order_acquire)) {
+      std::unordered_map<uintptr_t, OverflowEntry> overflow;
+      {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        overflow.swap(overflow_);
+        has_overflow_.store(false, std::memory_order_release);
+      }
+      for (auto& [id, entry] : overflow) {
+        entry.callback(frame_start_time, frame_target_time);
+        ++count;
+      }
+    }
+    stats_.callback_count.fetch_add(count, std::memory_order_relaxed);
+    return count;
+  }
+
+  bool Empty() const {
+    return occupied_.load(std::memory_order_acquire) == 0 &&
+           !has_overflow_.load(std::memory_order_acquire);
+  }
+
+  VSyncDispatchStats GetStats() const {
+    VSyncDispatchStats stats;
+    stats.frame_count = stats_.frame_count.load(std::memory_order_relaxed);
+    stats.callback_count =
+        stats_.callback_count.load(std::memory_order_relaxed);
+    stats.total_latency_ns =
+        stats_.total_latency_ns.load(std::memory_order_relaxed);
+    stats.max_latency_ns =
+        stats_.max_latency_ns.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  static constexpr uint32_t kPhaseBits = 2;
+  static constexpr uint32_t kPhaseMask = (1u << kPhaseBits) - 1;
+  static constexpr uint32_t kFree = 0;
+  static constexpr uint32_t kWriting = 1;
+  static constexpr uint32_t kReady = 2;
+  static constexpr uint32_t kTaking = 3;
+  // Index of the handles to overflow callbacks, which carry a sequence number
+  // in place of the generation.
+  static constexpr size_t kOverflowIndex = Capacity;
+
+  struct Slot {
+    // Generation in the high bits, phase in the low ones.
+    std::atomic<uint32_t> state{0};
+    std::atomic<uintptr_t> id{0};
+    alignas(Callback) unsigned char storage[sizeof(Callback)];
+
+    Callback& callback() {
+      return *std::launder(reinterpret_cast<Callback*>(storage));
+    }
+  };
+
+  struct OverflowEntry {
+    uint32_t sequence;
+    Callback callback;
+  };
+
+  struct AtomicStats {
+    std::atomic<uint64_t> frame_count{0};
+    std::atomic<uint64_t> callback_count{0};
+    std::atomic<int64_t> total_latency_ns{0};
+    std::atomic<int64_t> max_latency_ns{0};
+  };
+
+  static uint32_t PhaseOf(uint32_t state) { return state & kPhaseMask; }
+  static uint32_t GenerationOf(uint32_t state) { return state >> kPhaseBits; }
+  static uint32_t WithPhase(uint32_t state, uint32_t phase) {
+    return (state & ~kPhaseMask) | phase;
+  }
+  static uint64_t Bit(size_t index) { return uint64_t(1) << index; }
+
+  // The generation is stored plus one so that no handle is kInvalidHandle.
+  static Handle MakeHandle(size_t index, uint32_t generation) {
+    return (Handle(generation) + 1) << 32 | index;
+  }
+  static size_t IndexOf(Handle handle) {
+    return static_cast<size_t>(handle & 0xffffffffu);
+  }
+  static uint32_t GenerationOfHandle(Handle handle) {
+    return static_cast<uint32_t>((handle >> 32) - 1);
+  }
+
+  static size_t CountTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(bits));
+#else
+    size_t count = 0;
+    while ((bits & 1) == 0) {
+      bits >>= 1;
+      ++count;
+    }
+    return count;
+#endif
+  }
+
+  // Frees a slot in the taking phase and returns its callback.
+  Callback Take(size_t index, uint32_t state) {
+    Slot& slot = slots_[index];
+    Callback callback = std::move(slot.callback());
+    slot.callback().~Callback();
+    // Cleared before the slot is freed, otherwise it could clear the bit of
+    // the next callback claiming the slot.
+    occupied_.fetch_and(~Bit(index), std::memory_order_relaxed);
+    const uint32_t next_generation =
+        (GenerationOf(state) + 1) & (~0u >> kPhaseBits);
+    slot.state.store(next_generation << kPhaseBits | kFree,
+                     std::memory_order_release);
+    return callback;
+  }
+
+  Handle ScheduleOverflow(uintptr_t id, Callback callback) {
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    const uint32_t sequence = overflow_sequence_++;
+    auto it = overflow_.find(id);
+    if (it != overflow_.end()) {
+      it->second = OverflowEntry{sequence, std::move(callback)};
+    } else {
+      overflow_.emplace(id, OverflowEntry{sequence, std::move(callback)});
+    }
+    has_overflow_.store(true, std::memory_order_release);
+    return MakeHandle(kOverflowIndex, sequence);
+  }
+
+  bool CancelOverflow(uint32_t sequence) {
+    // Destroyed outside of the lock, like the callbacks of the slots.
+    typename std::unordered_map<uintptr_t, OverflowEntry>::node_type node;
+    {
+      std::lock_guard<std::mutex> lock(overflow_mutex_);
+      auto it = overflow_.begin();
+      while (it != overflow_.end() && it->second.sequence != sequence) {
+        ++it;
+      }
+      if (it == overflow_.end()) {
+        return false;
+      }
+      node = overflow_.extract(it);
+      has_overflow_.store(!overflow_.empty(), std::memory_order_release);
+    }
+    return true;
+  }
+
+  void RecordFrame(int64_t latency) {
+    latency = std::max<int64_t>(latency, 0);
+    stats_.frame_count.fetch_add(1, std::memory_order_relaxed);
+    stats_.total_latency_ns.fetch_add(latency, std::memory_order_relaxed);
+    int64_t max = stats_.max_latency_ns.load(std::memory_order_relaxed);
+    while (latency > max && !stats_.max_latency_ns.compare_exchange_weak(
+                                max, latency, std::memory_order_relaxed)) {
+    }
+  }
+
+  Slot slots_[Capacity];
+  std::atomic<uint64_t> occupied_{0};
+  AtomicStats stats_;
+
+  std::atomic<bool> has_overflow_{false};
+  std::mutex overflow_mutex_;
+  std::unordered_map<uintptr_t, OverflowEntry> overflow_;
+  uint32_t overflow_sequence_{0};
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(VSyncCallbackSlab);
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // CORE_BASE_THREADING_VSYNC_CALLBACK_SLAB_H_
@@ -0,0 +1,165 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_WORK_STEALING_DEQUE_H_
+#define BASE_INCLUDE_FML_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "base/include/fml/macros.h"
+
+namespace lynx {
+namespace fml {
+
+// Chase-Lev work stealing deque, following "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Nardelli 2013).
+//
+// Only the owner thread may call Push() and Pop(), which operate on the bottom
+// end without contention in the common case. Any thread may call Steal(),
+// which takes from the top end. T is stored in atomic slots and therefore
+// must be trivially copyable; store pointers for anything larger.
+//
+// The backing ring grows on demand. Retired rings are kept alive until the
+// deque is destroyed since a concurrent thief may still be reading from them.
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingDeque requires trivially copyable elements.");
+
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 256)
+      : top_(0), bottom_(0) {
+    size_t capacity = 1;
+    while (capacity < initial_capacity) {
+      capacity <<= 1;
+    }
+    rings_.emplace_back(std::make_unique<Ring>(capacity));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  ~WorkStealingDeque() = default;
+
+  // Owner thread only.
+  void Push(T item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(ring->capacity()) - 1) {
+      ring = Grow(ring, bottom, top);
+    }
+    ring->Store(bottom, item);
+    // Publishes the item to thieves, pairs with the acquire load in Steal().
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner thread only. Takes the most recently pushed item.
+  bool Pop(T& out) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = ring->Load(bottom);
+    if (top == bottom) {
+      // Last item, race against thieves for it.
+      bool won = top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // Any thread. Takes the least recently pushed item. May fail spuriously when
+  // racing with another thief or the owner; callers should treat false as
+  // "nothing stolen this time" rather than "empty".
+  bool Steal(T& out) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return false;
+    }
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    T item = ring->Load(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    out = item;
+    return true;
+  }
+
+  // Approximate when called concurrently with Push/Pop/Steal.
+  size_t Size() const {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+  }
+
+  bool Empty() const { return Size() == 0; }
+
+ private:
+  class Ring {
+   public:
+    explicit Ring(size_t capacity)
+        : mask_(capacity - 1), slots_(new std::atomic<T>[capacity]) {}
+
+    size_t capacity() const { return mask_ + 1; }
+
+    T Load(int64_t index) const {
+      return slots_[static_cast<size_t>(index) & mask_].load(
+          std::memory_order_relaxed);
+    }
+
+    void Store(int64_t index, T item) {
+      slots_[static_cast<size_t>(index) & mask_].store(
+          item, std::memory_order_relaxed);
+    }
+
+   private:
+    const size_t mask_;
+    std::unique_ptr<std::atomic<T>[]> slots_;
+  };
+
+  Ring* Grow(Ring* ring, int64_t bottom, int64_t top) {
+    rings_.emplace_back(std::make_unique<Ring>(ring->capacity() << 1));
+    Ring* grown = rings_.back().get();
+    for (int64_t i = top; i < bottom; ++i) {
+      grown->Store(i, ring->Load(i));
+    }
+    ring_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  // top_ is written by thieves and bottom_ by the owner, keep them on separate
+  // cache lines to avoid false sharing.
+  alignas(64) std::atomic<int64_t> top_;
+  alignas(64) std::atomic<int64_t> bottom_;
+  alignas(64) std::atomic<Ring*> ring_;
+  // Owned by the owner thread.
+  std::vector<std::unique_ptr<Ring>> rings_;
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(WorkStealingDeque);
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::WorkStealingDeque;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_WORK_STEALING_DEQUE_H_
@@ -0,0 +1,121 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_WORK_STEALING_MESSAGE_LOOP_H_
+#define BASE_INCLUDE_FML_WORK_STEALING_MESSAGE_LOOP_H_
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base/include/closure.h"
+#include "base/include/fml/macros.h"
+#include "base/include/fml/task_runner.h"
+#include "base/include/fml/thread.h"
+#include "base/include/fml/work_stealing_task_queue.h"
+
+namespace lynx {
+namespace fml {
+
+class WorkStealingTaskRunner;
+
+// Alternative to ConcurrentMessageLoop whose workers do not contend on a
+// single queue: every worker owns a deque, idle workers steal from the others
+// and park when nothing is left. See WorkStealingTaskQueue.
+//
+// It is a separate type so that ConcurrentMessageLoop keeps its layout and
+// symbols, callers opt in by creating this loop instead.
+class WorkStealingMessageLoop
+    : public std::enable_shared_from_this<WorkStealingMessageLoop> {
+ public:
+  static std::shared_ptr<WorkStealingMessageLoop> Create(
+      const std::string& name_prefix,
+      size_t worker_count = std::thread::hardware_concurrency(),
+      Thread::ThreadPriority priority = Thread::ThreadPriority::NORMAL,
+      const Thread::ThreadConfigSetter& setter = nullptr) {
+    return std::make_shared<WorkStealingMessageLoop>(name_prefix, worker_count,
+                                                     priority, setter);
+  }
+
+  WorkStealingMessageLoop(const std::string& name_prefix, size_t worker_count,
+                          Thread::ThreadPriority priority,
+                          const Thread::ThreadConfigSetter& setter)
+      : queue_(worker_count) {
+    const size_t count = queue_.GetWorkerCount();
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      Thread::ThreadConfig config(name_prefix + std::to_string(i + 1),
+                                  priority);
+      workers_.emplace_back([this, i, config = std::move(config), setter]() {
+        if (setter) {
+          setter(config);
+        } else {
+          Thread::SetCurrentThreadName(config);
+        }
+        queue_.RunWorker(static_cast<uint32_t>(i));
+      });
+    }
+  }
+
+  ~WorkStealingMessageLoop() { Terminate(); }
+
+  // Thread safe. Tasks posted after Terminate() are dropped.
+  void PostTask(base::closure task) { queue_.Push(std::move(task)); }
+
+  size_t GetWorkerCount() const { return queue_.GetWorkerCount(); }
+
+  std::shared_ptr<WorkStealingTaskRunner> GetTaskRunner();
+
+  // Runs the pending tasks and joins the workers. Must not be called on a
+  // worker of this loop.
+  void Terminate() {
+    queue_.Shutdown();
+    for (auto& worker : workers_) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+  }
+
+ private:
+  WorkStealingTaskQueue queue_;
+  std::vector<std::thread> workers_;
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(WorkStealingMessageLoop);
+};
+
+class WorkStealingTaskRunner : public BasicTaskRunner {
+ public:
+  explicit WorkStealingTaskRunner(
+      std::weak_ptr<WorkStealingMessageLoop> weak_loop)
+      : weak_loop_(std::move(weak_loop)) {}
+
+  void PostTask(base::closure task) override {
+    if (auto loop = weak_loop_.lock()) {
+      loop->PostTask(std::move(task));
+    }
+  }
+
+ private:
+  std::weak_ptr<WorkStealingMessageLoop> weak_loop_;
+
+  BASE_DISALLOW_COPY_AND_ASSIGN(WorkStealingTaskRunner);
+};
+
+inline std::shared_ptr<WorkStealingTaskRunner>
+WorkStealingMessageLoop::GetTaskRunner() {
+  return std::make_shared<WorkStealingTaskRunner>(weak_from_this());
+}
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::WorkStealingMessageLoop;
+using lynx::fml::WorkStealingTaskRunner;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_WORK_STEALING_MESSAGE_LOOP_H_
@@ -0,0 +1,255 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_WORK_STEALING_TASK_QUEUE_H_
+#define BASE_INCLUDE_FML_WORK_STEALING_TASK_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base/include/closure.h"
+#include "base/include/fml/macros.h"
+#include "base/include/fml/work_stealing_deque.h"
+
+namespace lynx {
+namespace fml {
+
+// Task queue backing WorkStealingMessageLoop.
+//
+// Every worker owns a WorkStealingDeque and a lock free inbox. Tasks posted by
+// a worker go to its own deque; tasks posted from other threads are spread
+// round-robin over the inboxes. An idle worker first drains its own inbox,
+// then steals from the deques and inboxes of the other workers, and finally
+// parks on a condition variable. Producers only touch the condition variable
+// when at least one worker is parked, so the hot path takes no lock.
+class WorkStealingTaskQueue {
+ public:
+  explicit WorkStealingTaskQueue(size_t worker_count)
+      : workers_(worker_count > 0 ? worker_count : 1) {
+    for (auto& worker : workers_) {
+      worker = std::make_unique<Worker>();
+    }
+  }
+
+  ~WorkStealingTaskQueue() {
+    // Workers have been joined, whatever is left is dropped.
+    for (auto& worker : workers_) {
+      Task* task = nullptr;
+      while (worker->deque.Pop(task)) {
+        delete task;
+      }
+      DeleteList(worker->inbox.exchange(nullptr));
+    }
+  }
+
+  size_t GetWorkerCount() const { return workers_.size(); }
+
+  // Thread safe. Tasks posted after Shutdown() are dropped.
+  void Push(base::closure task) {
+    if (shutdown_.load(std::memory_order_acquire)) {
+      return;
+    }
+    Task* node = new Task(std::move(task));
+    const WorkerContext& context = CurrentWorker();
+    if (context.queue == this) {
+      workers_[context.index]->deque.Push(node);
+    } else {
+      size_t index = next_inbox_.fetch_add(1, std::memory_order_relaxed) %
+                     workers_.size();
+      PushToInbox(*workers_[index], node);
+    }
+    WakeUpOne();
+  }
+
+  // Runs tasks on the calling thread as worker |index| until Shutdown() is
+  // called and no task is left.
+  void RunWorker(uint32_t index) {
+    CurrentWorker() = WorkerContext{this, index};
+    uint32_t seed = index * 2654435761u + 1u;
+    while (true) {
+      Task* task = FindTask(index, seed);
+      if (task == nullptr) {
+        for (int i = 0; i < kSpinRounds && task == nullptr; ++i) {
+          std::this_thread::yield();
+          task = FindTask(index, seed);
+        }
+      }
+      if (task != nullptr) {
+        task->closure();
+        delete task;
+        continue;
+      }
+      if (shutdown_.load(std::memory_order_acquire) && !HasTask()) {
+        break;
+      }
+      Park();
+    }
+    CurrentWorker() = WorkerContext();
+  }
+
+  // Wakes all parked workers. RunWorker() returns once the queues are drained.
+  void Shutdown() {
+    shutdown_.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    park_condition_.notify_all();
+  }
+
+ private:
+  static constexpr int kSpinRounds = 16;
+
+  struct Task {
+    explicit Task(base::closure closure) : closure(std::move(closure)) {}
+    base::closure closure;
+    Task* next = nullptr;
+  };
+
+  struct alignas(64) Worker {
+    WorkStealingDeque<Task*> deque;
+    // Treiber stack, newest first.
+    std::atomic<Task*> inbox{nullptr};
+  };
+
+  struct WorkerContext {
+    const WorkStealingTaskQueue* queue = nullptr;
+    uint32_t index = 0;
+  };
+
+  static WorkerContext& CurrentWorker() {
+    static thread_local WorkerContext context;
+    return context;
+  }
+
+  static void PushToInbox(Worker& worker, Task* node) {
+    node->next = worker.inbox.load(std::memory_order_relaxed);
+    while (!worker.inbox.compare_exchange_weak(node->next, node,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+    }
+  }
+
+  static void DeleteList(Task* head) {
+    while (head != nullptr) {
+      Task* next = head->next;
+      delete head;
+      head = next;
+    }
+  }
+
+  // Moves the whole inbox of |from| into the deque of worker |to|. The inbox is
+  // newest first, pushing it in that order leaves the oldest task at the
+  // bottom so that it is popped first.
+  bool MoveInbox(Worker& from, Worker& to) {
+    Task* head = from.inbox.exchange(nullptr, std::memory_order_acquire);
+    if (head == nullptr) {
+      return false;
+    }
+    while (head != nullptr) {
+      Task* next = head->next;
+      head->next = nullptr;
+      to.deque.Push(head);
+      head = next;
+    }
+    return true;
+  }
+
+  Task* FindTask(uint32_t index, uint32_t& seed) {
+    Worker& self = *workers_[index];
+    Task* task = nullptr;
+    if (self.deque.Pop(task)) {
+      return task;
+    }
+    if (MoveInbox(self, self) && self.deque.Pop(task)) {
+      return task;
+    }
+    const size_t count = workers_.size();
+    if (count == 1) {
+      return nullptr;
+    }
+    // xorshift32, only used to spread thieves over victims.
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    const size_t start = seed % count;
+    for (size_t i = 0; i < count; ++i) {
+      size_t victim = (start + i) % count;
+      if (victim == index) {
+        continue;
+      }
+      if (workers_[victim]->deque.Steal(task)) {
+        return task;
+      }
+    }
+    // The victims may be busy with long tasks while their inboxes fill up.
+    for (size_t i = 0; i < count; ++i) {
+      size_t victim = (start + i) % count;
+      if (victim != index && MoveInbox(*workers_[victim], self) &&
+          self.deque.Pop(task)) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  bool HasTask() const {
+    for (const auto& worker : workers_) {
+      if (!worker->deque.Empty() ||
+          worker->inbox.load(std::memory_order_acquire) != nullptr) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void WakeUpOne() {
+    // Pairs with the fence in Park(): either the producer sees the sleeper or
+    // the sleeper sees the task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    park_condition_.notify_one();
+  }
+
+  void Park() {
+    sleepers_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    if (!HasTask() && !shutdown_.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      park_condition_.wait(lock, [this, epoch] {
+        return epoch_.load(std::memory_order_acquire) != epoch ||
+               shutdown_.load(std::memory_order_acquire);
+      });
+    }
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  alignas(64) std::atomic<size_t> next_inbox_{0};
+  alignas(64) std::atomic<uint32_t> sleepers_{0};
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic_bool shutdown_{false};
+  std::mutex park_mutex_;
+  std::condition_variable park_condition_;
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(WorkStealingTaskQueue);
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::WorkStealingTaskQueue;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_WORK_STEALING_TASK_QUEUE_H_
@@ -0,0 +1,389 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_CONCURRENT_RING_QUEUE_H_
+#define BASE_INCLUDE_CONCURRENT_RING_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "base/include/fml/macros.h"
+
+namespace lynx {
+namespace base {
+
+/*
+  Multi producer single consumer queue with the Push/PopAll interface of
+  ConcurrentQueue, for hot queues drained in batches such as the UI operation
+  queue (see LynxUIOperationRingQueue). Unlike ConcurrentQueue it has a single
+  consumer and no ReversePopAll(); callers with several consumers must
+  serialize them.
+
+  Elements are stored in place in cache line aligned segments of SegmentSize
+  slots instead of one heap node per element. Producers claim a slot with a
+  single fetch_add on the tail segment; when it is full the next segment is
+  linked, taken from a recycled spare if possible. Drained segments are
+  recycled by the consumer, so in steady state the queue behaves like a ring
+  of two segments and does not allocate at all.
+
+  PopAll() returns the published elements in pushed order without copying or
+  reversing them. They stay in their slots until the returned container is
+  destroyed, hence:
+    - PopAll() and the container must be used by one consumer at a time.
+    - The previous container must be destroyed before the next PopAll().
+    - The queue must outlive its containers.
+*/
+template <typename T, size_t SegmentSize = 64>
+class ConcurrentRingQueue {
+  static_assert(SegmentSize > 0, "SegmentSize must be positive.");
+
+  struct Slot {
+    std::atomic<bool> ready{false};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T& data() { return *std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  struct alignas(64) Segment {
+    // Written by producers.
+    std::atomic<size_t> claimed{0};
+    std::atomic<Segment*> next{nullptr};
+    // Written by the consumer.
+    alignas(64) std::atomic<size_t> consumed{0};
+    Segment* retired_next{nullptr};
+    Slot slots[SegmentSize];
+  };
+
+ public:
+  struct Iterator {
+    using difference_type = ptrdiff_t;
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using iterator_category = std::forward_iterator_tag;
+
+    Segment* segment;
+    size_t index;
+    size_t remaining;
+
+    Iterator() : segment(nullptr), index(0), remaining(0) {}
+    Iterator(Segment* segment, size_t index, size_t remaining)
+        : segment(segment), index(index), remaining(remaining) {
+      Normalize();
+    }
+
+    T& operator*() const { return segment->slots[index].data(); }
+
+    T* operator->() const { return &segment->slots[index].data(); }
+
+    Iterator& operator++() {
+      ++index;
+      --remaining;
+      Normalize();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator t(*this);
+      ++(*this);
+      return t;
+    }
+
+    friend bool operator==(const Iterator& x, const Iterator& y) {
+      return x.remaining == y.remaining;
+    }
+
+    friend bool operator!=(const Iterator& x, const Iterator& y) {
+      return !(x == y);
+    }
+
+   private:
+    void Normalize() {
+      if (remaining != 0 && index == SegmentSize) {
+        segment = segment->next.load(std::memory_order_relaxed);
+        index = 0;
+      }
+    }
+  };
+
+  struct IterableContainer {
+    IterableContainer() = default;
+
+    IterableContainer(const IterableContainer&) = delete;
+    IterableContainer& operator=(const IterableContainer&) = delete;
+    IterableContainer(IterableContainer&& other) { MoveFrom(other); }
+    IterableContainer& operator=(IterableContainer&& other) {
+      if (this != &other) {
+        reset();
+        MoveFrom(other);
+      }
+      return *this;
+    }
+
+    ~IterableContainer() { reset(); }
+
+    bool empty() const { return count_ == 0; }
+
+    Iterator begin() { return Iterator(first_, begin_, count_); }
+
+    Iterator end() { return Iterator(); }
+
+    Iterator begin() const { return Iterator(first_, begin_, count_); }
+
+    Iterator end() const { return Iterator(); }
+
+    T& front() { return *begin(); }
+
+    size_t size() const { return count_; }
+
+    // Destroys the elements and hands their segments back to the queue.
+    void reset() {
+      if (owner_ != nullptr) {
+        owner_->Release(first_, begin_, count_, last_);
+        owner_ = nullptr;
+        count_ = 0;
+      }
+    }
+
+   private:
+    friend class ConcurrentRingQueue;
+
+    IterableContainer(ConcurrentRingQueue* owner, Segment* first, size_t begin,
+                      size_t count, Segment* last)
+        : owner_(owner),
+          first_(first),
+          last_(last),
+          begin_(begin),
+          count_(count) {}
+
+    void MoveFrom(IterableContainer& other) {
+      owner_ = other.owner_;
+      first_ = other.first_;
+      last_ = other.last_;
+      begin_ = other.begin_;
+      count_ = other.count_;
+      other.owner_ = nullptr;
+      other.count_ = 0;
+    }
+
+    ConcurrentRingQueue* owner_{nullptr};
+    Segment* first_{nullptr};
+    // Segment the consumer stopped in, every segment before it is drained.
+    Segment* last_{nullptr};
+    size_t begin_{0};
+    size_t count_{0};
+  };
+
+  ConcurrentRingQueue() : head_(new Segment()) {
+    tail_.store(head_, std::memory_order_relaxed);
+    head_for_readers_.store(head_, std::memory_order_relaxed);
+  }
+
+  ~ConcurrentRingQueue() {
+    LYNX_BASE_DCHECK(!draining_);
+    // Destroys what was never popped, then frees every segment.
+    PopAll().reset();
+    ReclaimRetired();
+    for (Segment* segment = head_; segment != nullptr;) {
+      Segment* next = segment->next.load(std::memory_order_relaxed);
+      delete segment;
+      segment = next;
+    }
+    delete spare_.load(std::memory_order_relaxed);
+  }
+
+  void Push(T data) {
+    ProducerScope scope(this);
+    Segment* segment = tail_.load(std::memory_order_acquire);
+    for (;;) {
+      const size_t index =
+          segment->claimed.fetch_add(1, std::memory_order_relaxed);
+      if (index < SegmentSize) {
+        Slot& slot = segment->slots[index];
+        new (slot.storage) T(std::move(data));
+        // Publishes the element, pairs with the acquire load in PopAll().
+        slot.ready.store(true, std::memory_order_release);
+        return;
+      }
+      // Segment full, link the next one unless somebody else already did.
+      Segment* next = segment->next.load(std::memory_order_acquire);
+      if (next == nullptr) {
+        Segment* fresh = AcquireSegment();
+        if (segment->next.compare_exchange_strong(next, fresh,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+          next = fresh;
+        } else {
+          RecycleSegment(fresh);
+        }
+      }
+      // Helps to advance the tail, on failure |segment| is the current tail.
+      if (tail_.compare_exchange_strong(segment, next,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+        segment = next;
+      }
+    }
+  }
+
+  // Moves all the elements of |other| to the end of self, in order. Must be
+  // called on the consumer thread of |other|.
+  void Push(ConcurrentRingQueue& other) {
+    auto elements = other.PopAll();
+    for (auto& element : elements) {
+      Push(std::move(element));
+    }
+  }
+
+  IterableContainer PopAll() {
+    LYNX_BASE_DCHECK(!draining_);
+    ReclaimRetired();
+    Segment* first = head_;
+    const size_t begin = head_index_;
+    size_t count = 0;
+    for (;;) {
+      if (head_index_ == SegmentSize) {
+        Segment* next = head_->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+          break;
+        }
+        head_->consumed.store(SegmentSize, std::memory_order_release);
+        head_ = next;
+        head_index_ = 0;
+        head_for_readers_.store(head_, std::memory_order_release);
+        continue;
+      }
+      // Stops at the first slot not yet published, which keeps FIFO order.
+      if (!head_->slots[head_index_].ready.load(std::memory_order_acquire)) {
+        break;
+      }
+      ++head_index_;
+      ++count;
+    }
+    head_->consumed.store(head_index_, std::memory_order_release);
+    if (count == 0 && first == head_) {
+      return IterableContainer();
+    }
+    draining_ = true;
+    return IterableContainer(this, first, begin, count, head_);
+  }
+
+  // Thread safe but approximate while producers are pushing.
+  bool Empty() {
+    ProducerScope scope(this);
+    Segment* segment = head_for_readers_.load(std::memory_order_acquire);
+    size_t index = segment->consumed.load(std::memory_order_acquire);
+    if (index == SegmentSize) {
+      segment = segment->next.load(std::memory_order_acquire);
+      index = 0;
+      if (segment == nullptr) {
+        return true;
+      }
+    }
+    return !segment->slots[index].ready.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Marks a thread which may hold a pointer to a segment obtained from tail_
+  // or head_for_readers_. Segments are only recycled while none is active.
+  class ProducerScope {
+   public:
+    explicit ProducerScope(ConcurrentRingQueue* queue) : queue_(queue) {
+      queue_->active_producers_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~ProducerScope() {
+      queue_->active_producers_.fetch_sub(1, std::memory_order_release);
+    }
+
+   private:
+    ConcurrentRingQueue* queue_;
+  };
+
+  Segment* AcquireSegment() {
+    if (Segment* segment = spare_.exchange(nullptr, std::memory_order_acquire)) {
+      return segment;
+    }
+    return new Segment();
+  }
+
+  void RecycleSegment(Segment* segment) {
+    Segment* expected = nullptr;
+    if (!spare_.compare_exchange_strong(expected, segment,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+      delete segment;
+    }
+  }
+
+  void Release(Segment* segment, size_t index, size_t count, Segment* last) {
+    for (; count != 0; --count) {
+      if (index == SegmentSize) {
+        segment = segment->next.load(std::memory_order_relaxed);
+        index = 0;
+      }
+      Slot& slot = segment->slots[index++];
+      slot.data().~T();
+      slot.ready.store(false, std::memory_order_relaxed);
+    }
+    for (Segment* drained = first_unreleased_; drained != last;) {
+      Segment* next = drained->next.load(std::memory_order_relaxed);
+      drained->retired_next = retired_;
+      retired_ = drained;
+      drained = next;
+    }
+    first_unreleased_ = last;
+    draining_ = false;
+    ReclaimRetired();
+  }
+
+  // Recycles drained segments once no producer can still reach them.
+  void ReclaimRetired() {
+    if (retired_ == nullptr ||
+        active_producers_.load(std::memory_order_seq_cst) != 0) {
+      return;
+    }
+    Segment* tail = tail_.load(std::memory_order_seq_cst);
+    Segment* keep = nullptr;
+    while (Segment* segment = retired_) {
+      retired_ = segment->retired_next;
+      if (segment == tail) {
+        // A producer linked the next segment but did not move the tail yet.
+        segment->retired_next = keep;
+        keep = segment;
+        continue;
+      }
+      segment->claimed.store(0, std::memory_order_relaxed);
+      segment->next.store(nullptr, std::memory_order_relaxed);
+      segment->consumed.store(0, std::memory_order_relaxed);
+      segment->retired_next = nullptr;
+      RecycleSegment(segment);
+    }
+    retired_ = keep;
+  }
+
+  // Producer side.
+  alignas(64) std::atomic<Segment*> tail_{nullptr};
+  alignas(64) std::atomic<size_t> active_producers_{0};
+  std::atomic<Segment*> spare_{nullptr};
+
+  // Consumer side.
+  alignas(64) Segment* head_;
+  size_t head_index_{0};
+  // First segment whose elements may still be held by a container.
+  Segment* first_unreleased_{head_};
+  Segment* retired_{nullptr};
+  bool draining_{false};
+  std::atomic<Segment*> head_for_readers_{nullptr};
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(ConcurrentRingQueue);
+};
+
+}  // namespace base
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_CONCURRENT_RING_QUEUE_H_
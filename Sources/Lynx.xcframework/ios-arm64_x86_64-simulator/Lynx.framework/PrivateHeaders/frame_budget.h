@@ -0,0 +1,107 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_FRAME_BUDGET_H_
+#define BASE_INCLUDE_FML_FRAME_BUDGET_H_
+
+#include <algorithm>
+
+#include "base/include/fml/task_source_grade.h"
+#include "base/include/fml/time/time_delta.h"
+#include "base/include/fml/time/time_point.h"
+
+namespace lynx {
+namespace fml {
+
+/**
+ * Tracks how much of the current frame is left on a vsync aligned thread, fed
+ * with the frame_start/frame_target pair of a VSyncMonitor::Callback.
+ *
+ * While a frame is in flight and its remaining budget drops below the reserve
+ * of a grade, tasks of that grade are deferred to the frame target so that the
+ * rendering work of the frame is not delayed by them:
+ *   - kIdle tasks only run in the first half of a frame or between frames.
+ *   - kUnspecified tasks run until the last kUnspecifiedReserveRatio of it.
+ *   - the other grades are never deferred.
+ * Low priority work is therefore time sliced into the gaps between the frames
+ * instead of being dropped. A task which has been deferred for longer than
+ * kMaxDeferral runs anyway, so a continuously busy frame cannot starve it.
+ *
+ * This is a policy only: whoever schedules the low priority work of the thread
+ * asks ShouldDefer() and re-posts the deferred work at FrameTarget(). The task
+ * queues themselves do not consult it.
+ *
+ * Not thread safe, use it from the thread the frames are produced on.
+ */
+class FrameBudget {
+ public:
+  static constexpr double kUnspecifiedReserveRatio = 0.25;
+  static constexpr double kIdleReserveRatio = 0.5;
+  static constexpr TimeDelta kMaxDeferral = TimeDelta::FromMilliseconds(100);
+
+  FrameBudget() = default;
+
+  bool IsEnabled() const { return enabled_; }
+
+  // Turning the budget off drops the current frame, so nothing is deferred.
+  void SetEnabled(bool enabled) {
+    enabled_ = enabled;
+    if (!enabled) {
+      frame_start_ = TimePoint();
+      frame_target_ = TimePoint();
+    }
+  }
+
+  void OnVSync(TimePoint frame_start, TimePoint frame_target) {
+    if (frame_target > frame_start) {
+      frame_start_ = frame_start;
+      frame_target_ = frame_target;
+    }
+  }
+
+  bool IsInFrame(TimePoint now) const {
+    return enabled_ && frame_start_ <= now && now < frame_target_;
+  }
+
+  TimeDelta Remaining(TimePoint now) const {
+    return IsInFrame(now) ? frame_target_ - now : TimeDelta::Zero();
+  }
+
+  TimePoint FrameTarget() const { return frame_target_; }
+
+  // Returns true if a task of |grade| which became runnable at |target_time|
+  // should wait for FrameTarget() instead of running at |now|.
+  bool ShouldDefer(TaskSourceGrade grade, TimePoint target_time,
+                   TimePoint now) const {
+    double reserve_ratio;
+    switch (grade) {
+      case TaskSourceGrade::kUnspecified:
+        reserve_ratio = kUnspecifiedReserveRatio;
+        break;
+      case TaskSourceGrade::kIdle:
+        reserve_ratio = kIdleReserveRatio;
+        break;
+      default:
+        return false;
+    }
+    if (!IsInFrame(now) || now - std::min(target_time, now) >= kMaxDeferral) {
+      return false;
+    }
+    return frame_target_ - now < (frame_target_ - frame_start_) * reserve_ratio;
+  }
+
+ private:
+  bool enabled_{false};
+  TimePoint frame_start_;
+  TimePoint frame_target_;
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::FrameBudget;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_FRAME_BUDGET_H_
@@ -6,10 +6,17 @@
 #define BASE_INCLUDE_LRU_CACHE_H_
 #include <stddef.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <functional>
 #include <list>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace lynx {
 namespace base {
@@ -59,6 +66,345 @@ class LRUCache {
       cache_map_;
 };
 
+/**
+ IntrusiveLRUCache is an LRU cache bounded by a budget rather than by a fixed
+ entry count.
+
+ Every entry is charged by the `size_of` callback (1 per entry if not given, in
+ which case the budget is an entry count like LRUCache). When the total charge
+ exceeds the budget, least recently used entries are evicted and reported to
+ the optional `on_evict` callback before being destroyed.
+
+ Nodes are intrusive: each node carries its LRU links and its hash chain link,
+ so an entry costs a single node and no std::list or std::unordered_map node.
+ Nodes are carved from slabs and recycled through a free list, so Put() does
+ not allocate once the cache has warmed up.
+
+ Not thread safe, see ShardedLRUCache.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Pred = std::equal_to<Key>>
+class IntrusiveLRUCache {
+ public:
+  using SizeOf = std::function<size_t(const Key&, const Value&)>;
+  using EvictionCallback = std::function<void(const Key&, Value&)>;
+
+  explicit IntrusiveLRUCache(size_t budget, SizeOf size_of = nullptr,
+                             EvictionCallback on_evict = nullptr)
+      : budget_(budget),
+        size_of_(std::move(size_of)),
+        on_evict_(std::move(on_evict)) {}
+
+  ~IntrusiveLRUCache() {
+    Clear();
+    for (void* slab : slabs_) {
+      std::free(slab);
+    }
+  }
+
+  IntrusiveLRUCache(const IntrusiveLRUCache&) = delete;
+  IntrusiveLRUCache& operator=(const IntrusiveLRUCache&) = delete;
+
+  Value* Get(const Key& key) {
+    Node* node = Find(key, hash_(key));
+    if (node == nullptr) {
+      return nullptr;
+    }
+    MoveToFront(node);
+    return &node->value;
+  }
+
+  // Looks up without touching the recency order.
+  const Value* Peek(const Key& key) const {
+    const Node* node =
+        const_cast<IntrusiveLRUCache*>(this)->Find(key, hash_(key));
+    return node != nullptr ? &node->value : nullptr;
+  }
+
+  bool Contains(const Key& key) const { return Peek(key) != nullptr; }
+
+  void Put(const Key& key, Value value) {
+    const size_t hash = hash_(key);
+    const size_t charge = Charge(key, value);
+    if (Node* node = Find(key, hash); node != nullptr) {
+      total_charge_ = total_charge_ - node->charge + charge;
+      node->charge = charge;
+      node->value = std::move(value);
+      MoveToFront(node);
+    } else {
+      node = new (AllocNode()) Node(key, std::move(value), hash, charge);
+      // Insert into the bucket first, a rehash walks the LRU list.
+      InsertIntoBucket(node);
+      LinkFront(node);
+      total_charge_ += charge;
+      ++count_;
+    }
+    EvictToBudget();
+  }
+
+  bool Erase(const Key& key) {
+    Node* node = Find(key, hash_(key));
+    if (node == nullptr) {
+      return false;
+    }
+    RemoveNode(node);
+    return true;
+  }
+
+  void Clear() {
+    Link* link = head_.next;
+    while (link != &head_) {
+      Link* next = link->next;
+      DestroyNode(static_cast<Node*>(link));
+      link = next;
+    }
+    head_.prev = head_.next = &head_;
+    std::fill(buckets_.begin(), buckets_.end(), nullptr);
+    count_ = 0;
+    total_charge_ = 0;
+  }
+
+  // Shrinking the budget evicts immediately.
+  void SetBudget(size_t budget) {
+    budget_ = budget;
+    EvictToBudget();
+  }
+
+  size_t budget() const { return budget_; }
+
+  size_t charge() const { return total_charge_; }
+
+  size_t size() const { return count_; }
+
+  bool empty() const { return count_ == 0; }
+
+ private:
+  struct Link {
+    Link* prev;
+    Link* next;
+  };
+
+  struct Node : Link {
+    Node* chain = nullptr;
+    size_t hash;
+    size_t charge;
+    Key key;
+    Value value;
+
+    Node(const Key& key, Value&& value, size_t hash, size_t charge)
+        : Link{nullptr, nullptr},
+          hash(hash),
+          charge(charge),
+          key(key),
+          value(std::move(value)) {}
+  };
+
+  static constexpr size_t kSlabNodeCount = 64;
+  static constexpr size_t kInitialBucketCount = 16;
+
+  size_t Charge(const Key& key, const Value& value) const {
+    return size_of_ ? size_of_(key, value) : 1;
+  }
+
+  Node* Find(const Key& key, size_t hash) {
+    if (buckets_.empty()) {
+      return nullptr;
+    }
+    for (Node* node = buckets_[hash & (buckets_.size() - 1)]; node != nullptr;
+         node = node->chain) {
+      if (node->hash == hash && pred_(node->key, key)) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  void InsertIntoBucket(Node* node) {
+    if (count_ + 1 > buckets_.size()) {
+      Rehash(buckets_.empty() ? kInitialBucketCount : buckets_.size() * 2);
+    }
+    Node*& bucket = buckets_[node->hash & (buckets_.size() - 1)];
+    node->chain = bucket;
+    bucket = node;
+  }
+
+  void RemoveFromBucket(Node* node) {
+    Node** link = &buckets_[node->hash & (buckets_.size() - 1)];
+    while (*link != node) {
+      link = &(*link)->chain;
+    }
+    *link = node->chain;
+  }
+
+  void Rehash(size_t bucket_count) {
+    std::vector<Node*> buckets(bucket_count, nullptr);
+    for (Link* link = head_.next; link != &head_; link = link->next) {
+      Node* node = static_cast<Node*>(link);
+      Node*& bucket = buckets[node->hash & (bucket_count - 1)];
+      node->chain = bucket;
+      bucket = node;
+    }
+    buckets_.swap(buckets);
+  }
+
+  void LinkFront(Node* node) {
+    node->prev = &head_;
+    node->next = head_.next;
+    head_.next->prev = node;
+    head_.next = node;
+  }
+
+  static void Unlink(Link* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+  }
+
+  void MoveToFront(Node* node) {
+    if (head_.next != node) {
+      Unlink(node);
+      LinkFront(node);
+    }
+  }
+
+  void EvictToBudget() {
+    // Always keep the most recently used entry even if it alone exceeds the
+    // budget, so that a Put() is observable by the following Get().
+    while (total_charge_ > budget_ && count_ > 1) {
+      Node* victim = static_cast<Node*>(head_.prev);
+      if (on_evict_) {
+        on_evict_(victim->key, victim->value);
+      }
+      RemoveNode(victim);
+    }
+  }
+
+  void RemoveNode(Node* node) {
+    Unlink(node);
+    RemoveFromBucket(node);
+    total_charge_ -= node->charge;
+    --count_;
+    DestroyNode(node);
+  }
+
+  void* AllocNode() {
+    if (free_list_ == nullptr) {
+      void* slab = std::malloc(sizeof(Node) * kSlabNodeCount);
+      if (slab == nullptr) {
+        // Base is built without exceptions.
+        abort();
+      }
+      slabs_.push_back(slab);
+      for (size_t i = 0; i < kSlabNodeCount; ++i) {
+        void* slot = static_cast<char*>(slab) + i * sizeof(Node);
+        *static_cast<void**>(slot) = free_list_;
+        free_list_ = slot;
+      }
+    }
+    void* slot = free_list_;
+    free_list_ = *static_cast<void**>(slot);
+    return slot;
+  }
+
+  void DestroyNode(Node* node) {
+    node->~Node();
+    void* slot = node;
+    *static_cast<void**>(slot) = free_list_;
+    free_list_ = slot;
+  }
+
+  size_t budget_;
+  size_t total_charge_{0};
+  size_t count_{0};
+  SizeOf size_of_;
+  EvictionCallback on_evict_;
+  Hash hash_;
+  Pred pred_;
+  // Sentinel of the circular LRU list, most recently used first.
+  Link head_{&head_, &head_};
+  std::vector<Node*> buckets_;
+  std::vector<void*> slabs_;
+  void* free_list_{nullptr};
+};
+
+/**
+ ShardedLRUCache spreads keys over ShardCount independently locked
+ IntrusiveLRUCache instances so that concurrent readers on different keys do
+ not contend on one mutex. The budget is split evenly between the shards.
+
+ Get() returns a copy of the value since a pointer into a shard would not
+ outlive the shard lock; keep values cheap to copy (e.g. shared_ptr). The
+ eviction callback runs with the shard lock held.
+ */
+template <typename Key, typename Value, size_t ShardCount = 8,
+          typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>>
+class ShardedLRUCache {
+  static_assert(ShardCount > 0, "ShardedLRUCache needs at least one shard.");
+
+ public:
+  using Shard = IntrusiveLRUCache<Key, Value, Hash, Pred>;
+
+  explicit ShardedLRUCache(
+      size_t budget, typename Shard::SizeOf size_of = nullptr,
+      typename Shard::EvictionCallback on_evict = nullptr) {
+    const size_t shard_budget = (budget + ShardCount - 1) / ShardCount;
+    for (auto& shard : shards_) {
+      shard.cache.emplace(shard_budget, size_of, on_evict);
+    }
+  }
+
+  std::optional<Value> Get(const Key& key) {
+    auto& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (Value* value = shard.cache->Get(key); value != nullptr) {
+      return *value;
+    }
+    return std::nullopt;
+  }
+
+  void Put(const Key& key, Value value) {
+    auto& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache->Put(key, std::move(value));
+  }
+
+  bool Erase(const Key& key) {
+    auto& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache->Erase(key);
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.cache->Clear();
+    }
+  }
+
+  size_t charge() {
+    size_t result = 0;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      result += shard.cache->charge();
+    }
+    return result;
+  }
+
+ private:
+  struct alignas(64) ShardSlot {
+    std::mutex mutex;
+    std::optional<Shard> cache;
+  };
+
+  ShardSlot& ShardFor(const Key& key) {
+    // Mix the high bits in, the shards' own buckets use the low bits.
+    size_t hash = Hash()(key);
+    hash ^= hash >> (sizeof(size_t) * 4);
+    return shards_[hash % ShardCount];
+  }
+
+  std::array<ShardSlot, ShardCount> shards_;
+};
+
 }  // namespace base
 }  // namespace lynx
 
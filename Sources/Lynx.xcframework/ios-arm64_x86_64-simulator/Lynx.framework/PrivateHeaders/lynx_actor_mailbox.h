@@ -0,0 +1,209 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_LYNX_ACTOR_MAILBOX_H_
+#define BASE_INCLUDE_LYNX_ACTOR_MAILBOX_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "base/include/closure.h"
+#include "base/include/concurrent_ring_queue.h"
+#include "base/include/fml/macros.h"
+#include "base/include/fml/time/time_delta.h"
+#include "base/include/fml/time/time_point.h"
+#include "base/include/lynx_actor.h"
+
+namespace lynx {
+namespace shell {
+
+struct LynxActorMailboxConfig {
+  // How long the first message of a batch may wait for others to join it
+  // before the batch is delivered. Zero delivers on the next turn of the
+  // target loop, which already coalesces what arrives in the meantime.
+  fml::TimeDelta max_batch_delay = fml::TimeDelta::Zero();
+};
+
+struct LynxActorMailboxStats {
+  uint64_t message_count = 0;
+  uint64_t batch_count = 0;
+  // Messages posted and not delivered yet.
+  uint64_t queue_depth = 0;
+  uint64_t max_queue_depth = 0;
+  // From posting a message to the start of the batch delivering it.
+  uint64_t total_latency_micros = 0;
+  uint64_t max_latency_micros = 0;
+};
+
+/**
+ * Multi producer mailbox which delivers the messages posted to a LynxActor
+ * from other threads in batches, one task per batch instead of one task per
+ * message. See LynxBatchedActor.
+ *
+ * Push() may be called from any thread and returns true when the caller must
+ * schedule a Drain() on the consumer thread; at most one drain is pending at
+ * any time. Messages are delivered in the order they were pushed.
+ */
+template <typename Message>
+class LynxActorMailbox {
+ public:
+  explicit LynxActorMailbox(LynxActorMailboxConfig config = {})
+      : config_(config) {}
+
+  const LynxActorMailboxConfig& config() const { return config_; }
+
+  bool Push(Message message) {
+    // Counted before the push so that a concurrent Drain() never subtracts
+    // a message which has not been added yet.
+    const uint64_t depth = depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    UpdateMax(max_depth_, depth);
+    queue_.Push(Envelope{std::move(message), fml::TimePoint::Now()});
+    // Pairs with the exchange in Drain(): either the pending drain sees the
+    // message, or the flag was cleared and this push schedules a new one.
+    return !drain_scheduled_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  // Delivers the pending messages as deliver(Message&) on the consumer
+  // thread. Returns the number of messages delivered.
+  template <typename Deliver>
+  size_t Drain(Deliver&& deliver) {
+    drain_scheduled_.exchange(false, std::memory_order_acq_rel);
+    auto batch = queue_.PopAll();
+    if (batch.empty()) {
+      return 0;
+    }
+    const fml::TimePoint now = fml::TimePoint::Now();
+    uint64_t total_latency = 0;
+    uint64_t max_latency = 0;
+    for (auto& envelope : batch) {
+      const int64_t latency = (now - envelope.post_time).ToMicroseconds();
+      const uint64_t value = latency > 0 ? static_cast<uint64_t>(latency) : 0;
+      total_latency += value;
+      max_latency = std::max(max_latency, value);
+    }
+    const size_t size = batch.size();
+    message_count_.fetch_add(size, std::memory_order_relaxed);
+    batch_count_.fetch_add(1, std::memory_order_relaxed);
+    total_latency_.fetch_add(total_latency, std::memory_order_relaxed);
+    UpdateMax(max_latency_, max_latency);
+
+    for (auto& envelope : batch) {
+      deliver(envelope.message);
+    }
+    batch.reset();
+    depth_.fetch_sub(size, std::memory_order_relaxed);
+    return size;
+  }
+
+  LynxActorMailboxStats GetStats() const {
+    LynxActorMailboxStats stats;
+    stats.message_count = message_count_.load(std::memory_order_relaxed);
+    stats.batch_count = batch_count_.load(std::memory_order_relaxed);
+    stats.queue_depth = depth_.load(std::memory_order_relaxed);
+    stats.max_queue_depth = max_depth_.load(std::memory_order_relaxed);
+    stats.total_latency_micros = total_latency_.load(std::memory_order_relaxed);
+    stats.max_latency_micros = max_latency_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  struct Envelope {
+    Message message;
+    fml::TimePoint post_time;
+  };
+
+  static void UpdateMax(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current &&
+           !max.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed)) {
+    }
+  }
+
+  const LynxActorMailboxConfig config_;
+  base::ConcurrentRingQueue<Envelope> queue_;
+  std::atomic<bool> drain_scheduled_{false};
+
+  std::atomic<uint64_t> depth_{0};
+  std::atomic<uint64_t> max_depth_{0};
+  std::atomic<uint64_t> message_count_{0};
+  std::atomic<uint64_t> batch_count_{0};
+  std::atomic<uint64_t> total_latency_{0};
+  std::atomic<uint64_t> max_latency_{0};
+
+  BASE_DISALLOW_COPY_ASSIGN_AND_MOVE(LynxActorMailbox);
+};
+
+/**
+ * Sends messages to a LynxActor through a LynxActorMailbox: everything posted
+ * from other threads before the target runner gets to it is delivered in one
+ * task, with BeforeInvoked/AfterInvoked around the whole batch. Messages
+ * posted on the actor's own thread run right away, like LynxActor::Act().
+ *
+ * It wraps the actor rather than being a mode of it, so that LynxActor keeps
+ * its layout, and the mailbox is fixed at construction, so that Act() may be
+ * called from any thread without further synchronization. Batched messages
+ * keep their order among themselves but not with respect to the Act* methods
+ * of the wrapped actor.
+ */
+template <typename T>
+class LynxBatchedActor {
+ public:
+  using Message = base::MoveOnlyClosure<void, std::unique_ptr<T>&>;
+
+  explicit LynxBatchedActor(std::shared_ptr<LynxActor<T>> actor,
+                            LynxActorMailboxConfig config = {})
+      : actor_(std::move(actor)),
+        mailbox_(std::make_shared<LynxActorMailbox<Message>>(config)) {}
+
+  template <typename F>
+  void Act(F&& func) {
+    if (actor_->CanRunNow()) {
+      actor_->Act(std::forward<F>(func));
+      return;
+    }
+    if (mailbox_->Push(Message(
+            [func = std::forward<F>(func)](std::unique_ptr<T>& impl) mutable {
+              func(impl);
+            }))) {
+      ScheduleDrain();
+    }
+  }
+
+  LynxActorMailboxStats GetMailboxStats() const {
+    return mailbox_->GetStats();
+  }
+
+  const std::shared_ptr<LynxActor<T>>& actor() const { return actor_; }
+
+ private:
+  // The drain holds the actor and the mailbox, so it outlives this wrapper.
+  void ScheduleDrain() {
+    auto drain = [mailbox = mailbox_](std::unique_ptr<T>& impl) {
+      mailbox->Drain([&impl](Message& message) { message(impl); });
+    };
+    const fml::TimeDelta delay = mailbox_->config().max_batch_delay;
+    if (delay > fml::TimeDelta::Zero()) {
+      actor_->GetRunner()->PostDelayedTask(
+          [actor = actor_, drain = std::move(drain)]() mutable {
+            actor->Act(std::move(drain));
+          },
+          delay);
+    } else {
+      actor_->ActAsync(std::move(drain));
+    }
+  }
+
+  const std::shared_ptr<LynxActor<T>> actor_;
+  const std::shared_ptr<LynxActorMailbox<Message>> mailbox_;
+};
+
+}  // namespace shell
+}  // namespace lynx
+
+#endif  // BASE_INCLUDE_LYNX_ACTOR_MAILBOX_H_
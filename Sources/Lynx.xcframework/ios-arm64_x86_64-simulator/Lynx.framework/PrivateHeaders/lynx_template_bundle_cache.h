@@ -0,0 +1,221 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_TEMPLATE_BUNDLE_LYNX_TEMPLATE_BUNDLE_CACHE_H_
+#define CORE_TEMPLATE_BUNDLE_LYNX_TEMPLATE_BUNDLE_CACHE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "base/include/lru_cache.h"
+#include "base/include/md5.h"
+#include "base/include/no_destructor.h"
+#include "core/renderer/css/css_style_sheet_manager.h"
+#include "core/template_bundle/lynx_template_bundle.h"
+
+namespace lynx {
+namespace tasm {
+
+struct LynxTemplateBundleCacheStats {
+  uint64_t hit_count = 0;
+  uint64_t miss_count = 0;
+  // Sum of the binary sizes of the cached bundles.
+  size_t charge = 0;
+};
+
+/**
+ * Process wide cache of decoded templates keyed by the MD5 of their binary,
+ * so that opening another view of a template already decoded, whatever its
+ * URL, skips the decode: header, string list, CSS and style object routes.
+ *
+ * The cache keeps one bundle per template, which is never loaded itself, and
+ * hands out copies of it. A copy gets its own instances of the state an
+ * instance mutates:
+ *   - CSSStyleSheetManager: stop flag, decoded set and flattened page
+ *     fragments. The raw fragment map is shared, as in pre-decoding, and the
+ *     copy has no CSSStyleSheetDelegate: the delegate of the decoding view
+ *     does not outlive it.
+ *   - LepusChunkManager: stop flag and chunk map, sharing the decoded chunks.
+ *   - page config, template info and custom sections, deep copies.
+ *   - no lepus context pool and no parse task scheduler, each instance
+ *     creates its own on demand.
+ * Everything else is shared and must not be modified after the decode: the
+ * raw CSS fragments, lepus chunks and context bundle, style objects, moulds,
+ * element template infos, parsed styles and the string list.
+ *
+ * Hence only fully decoded bundles may be inserted, i.e. decoded greedily
+ * with GreedyConstructElements() and without lazy CSS decoding, so that no
+ * copy ever adds a fragment to the shared map. Insert() rejects bundles with
+ * CSS lazy import enabled or with a routed fragment neither decoded nor
+ * looked up yet. Bundles decoded with devtool enabled, i.e. with a non empty
+ * GetBinary(), are never cached either, as devtool replaces CSS fragments in
+ * place.
+ *
+ * Entries are charged their binary size and the least recently used ones are
+ * evicted beyond the budget. Thread safe.
+ */
+class LynxTemplateBundleCache {
+ public:
+  static constexpr size_t kDefaultBudget = 16 * 1024 * 1024;
+
+  static LynxTemplateBundleCache& Instance() {
+    static base::NoDestructor<LynxTemplateBundleCache> instance(
+        kDefaultBudget);
+    return *instance;
+  }
+
+  explicit LynxTemplateBundleCache(size_t budget)
+      : cache_(budget, [](const std::string&, const Entry& entry) {
+          return Charge(*entry);
+        }) {}
+
+  LynxTemplateBundleCache(const LynxTemplateBundleCache&) = delete;
+  LynxTemplateBundleCache& operator=(const LynxTemplateBundleCache&) = delete;
+
+  // MD5 of the binary. Callers knowing a stable identity of the binary, e.g.
+  // a file path with its size and modification time, may use that as the key
+  // instead and skip the hashing.
+  static std::string ContentKey(const uint8_t* data, size_t size) {
+    return base::md5(reinterpret_cast<const char*>(data), size);
+  }
+
+  // Returns a copy of the bundle cached for |key|, if any.
+  std::optional<LynxTemplateBundle> Find(const std::string& key) {
+    std::optional<Entry> entry = cache_.Get(key);
+    if (!entry) {
+      miss_count_.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    hit_count_.fetch_add(1, std::memory_order_relaxed);
+    return CopyForInstance(**entry);
+  }
+
+  // |bundle| must be fully decoded, see the class comment. Returns false if
+  // it is not cacheable.
+  bool Insert(const std::string& key, const LynxTemplateBundle& bundle) {
+    if (!bundle.GetBinary().empty() || !IsCSSFullyDecoded(bundle)) {
+      return false;
+    }
+    cache_.Put(key, std::make_shared<LynxTemplateBundle>(bundle));
+    return true;
+  }
+
+  // Looks |key| up and calls |decode|, which returns
+  // std::optional<LynxTemplateBundle>, on a miss, caching its result.
+  template <typename Decode>
+  std::optional<LynxTemplateBundle> FindOrDecode(const std::string& key,
+                                                 Decode&& decode) {
+    if (auto bundle = Find(key)) {
+      return bundle;
+    }
+    std::optional<LynxTemplateBundle> bundle = decode();
+    if (bundle) {
+      Insert(key, *bundle);
+    }
+    return bundle;
+  }
+
+  template <typename Decode>
+  std::optional<LynxTemplateBundle> FindOrDecode(const uint8_t* data,
+                                                 size_t size, Decode&& decode) {
+    return FindOrDecode(ContentKey(data, size), std::forward<Decode>(decode));
+  }
+
+  bool Erase(const std::string& key) { return cache_.Erase(key); }
+
+  void Clear() { cache_.Clear(); }
+
+  LynxTemplateBundleCacheStats GetStats() {
+    LynxTemplateBundleCacheStats stats;
+    stats.hit_count = hit_count_.load(std::memory_order_relaxed);
+    stats.miss_count = miss_count_.load(std::memory_order_relaxed);
+    stats.charge = cache_.charge();
+    return stats;
+  }
+
+ private:
+  // Not const, the chunk manager is locked while it is copied.
+  using Entry = std::shared_ptr<LynxTemplateBundle>;
+
+  static size_t Charge(const LynxTemplateBundle& bundle) {
+    return std::max<size_t>(bundle.Size(), 1);
+  }
+
+  static bool IsCSSFullyDecoded(const LynxTemplateBundle& bundle) {
+    if (!bundle.css_style_manager_) {
+      return true;
+    }
+    CSSStyleSheetManager& css = *bundle.css_style_manager_;
+    if (css.enable_css_lazy_import_) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(css.fragment_mutex_);
+    for (const auto& range : css.route_.fragment_ranges) {
+      if (css.raw_fragments_->find(range.first) == css.raw_fragments_->end() &&
+          css.decoded_fragment_.find(range.first) ==
+              css.decoded_fragment_.end()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // See the class comment for what is copied and what is shared.
+  static LynxTemplateBundle CopyForInstance(LynxTemplateBundle& cached) {
+    LynxTemplateBundle copy(cached);
+
+    if (cached.css_style_manager_) {
+      CSSStyleSheetManager& source = *cached.css_style_manager_;
+      auto css = std::make_shared<CSSStyleSheetManager>(nullptr);
+      css->CopyFrom(source);
+      {
+        std::lock_guard<std::mutex> lock(source.fragment_mutex_);
+        css->decoded_fragment_ = source.decoded_fragment_;
+      }
+      css->route_ = source.route_;
+      css->enable_new_import_rule_ = source.enable_new_import_rule_;
+      css->enable_css_lazy_import_ = source.enable_css_lazy_import_;
+      css->fix_css_import_rule_order_ = source.fix_css_import_rule_order_;
+      copy.css_style_manager_ = std::move(css);
+    }
+
+    if (cached.lepus_chunk_manager_) {
+      LepusChunkManager& source = *cached.lepus_chunk_manager_;
+      auto chunks = std::make_shared<LepusChunkManager>();
+      {
+        std::lock_guard<std::mutex> lock(source.lepus_chunk_mutex_);
+        chunks->lepus_chunk_map_ = source.lepus_chunk_map_;
+        chunks->decoded_lepus_chunks_ = source.decoded_lepus_chunks_;
+      }
+      copy.lepus_chunk_manager_ = std::move(chunks);
+    }
+
+    if (cached.page_configs_) {
+      copy.page_configs_ = std::make_shared<PageConfig>(*cached.page_configs_);
+    }
+    copy.template_info_ = lepus::Value::Clone(cached.template_info_);
+    copy.custom_sections_ = lepus::Value::Clone(cached.custom_sections_);
+    copy.context_pool_ = nullptr;
+    copy.task_schedular_ = nullptr;
+    return copy;
+  }
+
+  // A single shard: the entries are few and large, and sharding would split
+  // the budget between them.
+  base::ShardedLRUCache<std::string, Entry, 1> cache_;
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+};
+
+}  // namespace tasm
+}  // namespace lynx
+
+#endif  // CORE_TEMPLATE_BUNDLE_LYNX_TEMPLATE_BUNDLE_CACHE_H_
@@ -0,0 +1,132 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_SHELL_LYNX_UI_OPERATION_RING_QUEUE_H_
+#define CORE_SHELL_LYNX_UI_OPERATION_RING_QUEUE_H_
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "base/include/concurrent_queue.h"
+#include "base/include/concurrent_ring_queue.h"
+#include "core/shell/lynx_ui_operation_queue.h"
+
+namespace lynx {
+namespace shell {
+
+/**
+ * LynxUIOperationQueue whose operations are kept in place in
+ * base::ConcurrentRingQueue segments instead of one heap node per operation,
+ * for pages flushing many operations every frame.
+ *
+ * ConcurrentRingQueue has a single consumer, whereas Flush() and ForceFlush()
+ * may be called from several threads, e.g. a sync flush from the UI thread.
+ * Consumers are therefore serialized by |consume_mutex_|, which is held from
+ * PopAll() until the popped operations are destroyed. Producers never take it.
+ * A flush from within an operation is a no-op, what it would have run is
+ * picked up by the next flush.
+ *
+ * A flush hands each popped batch to LynxUIOperationQueue::ConsumeOperations()
+ * as a single operation, so the operations run under the same long task
+ * monitoring and error reporting as with the base queue, at the cost of two
+ * queue nodes per flush rather than one per operation.
+ *
+ * LynxUIOperationQueue::Destroy() is not virtual: destroying through a
+ * pointer to the base queue stops the operations from running, but they are
+ * only released by the next flush or with the queue. Call Destroy() on this
+ * class to release them at once.
+ */
+class LynxUIOperationRingQueue : public LynxUIOperationQueue {
+ public:
+  explicit LynxUIOperationRingQueue(
+      int32_t instance_id = tasm::report::kUnknownInstanceId)
+      : LynxUIOperationQueue(instance_id) {}
+  ~LynxUIOperationRingQueue() override = default;
+
+  void EnqueueUIOperation(UIOperation operation) override {
+    if (!destroyed_) {
+      ring_operations_.Push(std::move(operation));
+    }
+  }
+
+  void EnqueueHighPriorityOperation(UIOperation operation) override {
+    if (!destroyed_) {
+      ring_high_priority_operations_.Push(std::move(operation));
+    }
+  }
+
+  // Hides LynxUIOperationQueue::Destroy() to also release the pending
+  // operations. From within an operation they are released when the running
+  // flush returns.
+  void Destroy() {
+    LynxUIOperationQueue::Destroy();
+    ConsumeRingOperations();
+  }
+
+  void Flush() override {
+    if (enable_flush_) {
+      ConsumeRingOperations();
+    }
+  }
+
+  void ForceFlush() override { ConsumeRingOperations(); }
+
+ private:
+  void ConsumeRingOperations() {
+    if (consumer_thread_.load(std::memory_order_relaxed) ==
+        std::this_thread::get_id()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(consume_mutex_);
+    consumer_thread_.store(std::this_thread::get_id(),
+                           std::memory_order_relaxed);
+    ConsumerScope scope(consumer_thread_);
+    // Popped even once destroyed, so that the operations are released.
+    auto high_priority_operations = ring_high_priority_operations_.PopAll();
+    auto operations = ring_operations_.PopAll();
+    if (destroyed_) {
+      return;
+    }
+    base::ConcurrentQueue<UIOperation> high_priority_batch;
+    if (!high_priority_operations.empty()) {
+      high_priority_batch.Push([&high_priority_operations]() {
+        for (auto& operation : high_priority_operations) {
+          operation();
+        }
+      });
+    }
+    base::ConcurrentQueue<UIOperation> batch;
+    if (!operations.empty()) {
+      batch.Push([&operations]() {
+        for (auto& operation : operations) {
+          operation();
+        }
+      });
+    }
+    ConsumeOperations(high_priority_batch.PopAll(), batch.PopAll());
+  }
+
+  // Resets the consumer thread once the popped operations are destroyed.
+  struct ConsumerScope {
+    explicit ConsumerScope(std::atomic<std::thread::id>& thread)
+        : thread(thread) {}
+    ~ConsumerScope() {
+      thread.store(std::thread::id(), std::memory_order_relaxed);
+    }
+    std::atomic<std::thread::id>& thread;
+  };
+
+  std::mutex consume_mutex_;
+  // Thread currently flushing, to detect a flush from within an operation.
+  std::atomic<std::thread::id> consumer_thread_{};
+  base::ConcurrentRingQueue<UIOperation> ring_operations_;
+  base::ConcurrentRingQueue<UIOperation> ring_high_priority_operations_;
+};
+
+}  // namespace shell
+}  // namespace lynx
+
+#endif  // CORE_SHELL_LYNX_UI_OPERATION_RING_QUEUE_H_
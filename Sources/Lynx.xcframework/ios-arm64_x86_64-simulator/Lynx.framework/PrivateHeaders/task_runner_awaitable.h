@@ -0,0 +1,308 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_TASK_RUNNER_AWAITABLE_H_
+#define BASE_INCLUDE_FML_TASK_RUNNER_AWAITABLE_H_
+
+// C++20 coroutine support for fml::TaskRunner. Everything here compiles away
+// for translation units built without coroutines.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define BASE_FML_HAS_COROUTINES 1
+#else
+#define BASE_FML_HAS_COROUTINES 0
+#endif
+
+#if BASE_FML_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "base/include/closure.h"
+#include "base/include/fml/task_runner.h"
+
+namespace lynx {
+namespace fml {
+
+/**
+ * Hops between runners inside a coroutine, so that a pipeline spanning the
+ * TASM, layout, JS and UI threads reads top to bottom instead of as nested
+ * PostTask lambdas:
+ *
+ *   fml::Task<> LoadAndApply(...) {
+ *     co_await fml::ResumeOn(js_runner);
+ *     auto script = co_await LoadScript(url);
+ *     co_await fml::ResumeOn(tasm_runner);
+ *     ...
+ *   }
+ *   fml::Detach(LoadAndApply(...));
+ *
+ * A hop posts one task holding the coroutine handle, which always fits inline
+ * in base::closure, and the locals live in the single coroutine frame instead
+ * of one heap allocated closure per stage.
+ *
+ * The runners must outlive the suspended coroutines: a runner dropping its
+ * pending tasks leaks the frames waiting on it.
+ */
+class ScheduleAwaitable {
+ public:
+  ScheduleAwaitable(fml::RefPtr<fml::TaskRunner> runner, bool always_post)
+      : runner_(std::move(runner)), always_post_(always_post) {}
+
+  bool await_ready() const {
+    return !always_post_ && runner_->RunsTasksOnCurrentThread();
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // Once posted, the coroutine may resume on the runner and destroy its
+    // frame, and |runner_| with it, before PostTask() returns.
+    fml::RefPtr<fml::TaskRunner> runner = runner_;
+    runner->PostTask([handle]() { handle.resume(); });
+  }
+
+  void await_resume() const {}
+
+ private:
+  fml::RefPtr<fml::TaskRunner> runner_;
+  bool always_post_;
+};
+
+/// Yields to |runner|: the coroutine continues in a new task of |runner|,
+/// even if it is already on its thread.
+inline ScheduleAwaitable Schedule(fml::RefPtr<fml::TaskRunner> runner) {
+  return ScheduleAwaitable(std::move(runner), true);
+}
+
+/// Continues on the thread of |runner|, without posting if already on it.
+inline ScheduleAwaitable ResumeOn(fml::RefPtr<fml::TaskRunner> runner) {
+  return ScheduleAwaitable(std::move(runner), false);
+}
+
+/**
+ * Adapts a callback based API, such as a resource load, into an awaitable.
+ * |start| is called with a base::MoveOnlyClosure<void, T> and must invoke it
+ * exactly once; the coroutine resumes on the thread invoking it, follow with
+ * ResumeOn() to get back to a given runner.
+ *
+ *   auto response = co_await fml::AwaitCallback<pub::LynxResourceResponse>(
+ *       [&](auto callback) {
+ *         loader->LoadResource(request, std::move(callback));
+ *       });
+ */
+template <typename T, typename Start>
+class CallbackAwaitable {
+ public:
+  explicit CallbackAwaitable(Start start) : start_(std::move(start)) {}
+
+  bool await_ready() const { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // The callback may resume, and so destroy, the coroutine before |start|
+    // returns, e.g. when invoked synchronously. |start| must not live in the
+    // coroutine frame then.
+    Start start = std::move(start_);
+    start(base::MoveOnlyClosure<void, T>([this, handle](T value) {
+      value_.emplace(std::move(value));
+      handle.resume();
+    }));
+  }
+
+  T await_resume() { return std::move(*value_); }
+
+ private:
+  Start start_;
+  std::optional<T> value_;
+};
+
+template <typename T, typename Start>
+CallbackAwaitable<T, std::decay_t<Start>> AwaitCallback(Start&& start) {
+  return CallbackAwaitable<T, std::decay_t<Start>>(std::forward<Start>(start));
+}
+
+namespace internal {
+
+template <typename Promise>
+struct TaskFinalAwaiter {
+  bool await_ready() const noexcept { return false; }
+
+  // Symmetric transfer to the awaiting coroutine, if any.
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<Promise> handle) noexcept {
+    std::coroutine_handle<> continuation = handle.promise().continuation;
+    return continuation ? continuation : std::noop_coroutine();
+  }
+
+  void await_resume() const noexcept {}
+};
+
+template <typename T>
+class TaskPromiseBase {
+ public:
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  // Lynx is built without exceptions.
+  void unhandled_exception() const noexcept { std::terminate(); }
+
+  std::coroutine_handle<> continuation;
+};
+
+}  // namespace internal
+
+/**
+ * Lazily started coroutine returning T. It starts when awaited, resumes its
+ * awaiter when done and is destroyed with the Task object. Use Detach() to
+ * start a top level one.
+ */
+template <typename T = void>
+class [[nodiscard]] Task {
+ public:
+  class promise_type : public internal::TaskPromiseBase<T> {
+   public:
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    internal::TaskFinalAwaiter<promise_type> final_suspend() noexcept {
+      return {};
+    }
+
+    template <typename U>
+    void return_value(U&& value) {
+      value_.emplace(std::forward<U>(value));
+    }
+
+    T TakeValue() { return std::move(*value_); }
+
+   private:
+    std::optional<T> value_;
+  };
+
+  Task(Task&& other) : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { Reset(); }
+
+  bool await_ready() const { return false; }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) {
+    handle_.promise().continuation = awaiter;
+    return handle_;
+  }
+
+  T await_resume() { return handle_.promise().TakeValue(); }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  void Reset() {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <>
+class [[nodiscard]] Task<void> {
+ public:
+  class promise_type : public internal::TaskPromiseBase<void> {
+   public:
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    internal::TaskFinalAwaiter<promise_type> final_suspend() noexcept {
+      return {};
+    }
+
+    void return_void() {}
+  };
+
+  Task(Task&& other) : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { Reset(); }
+
+  bool await_ready() const { return false; }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) {
+    handle_.promise().continuation = awaiter;
+    return handle_;
+  }
+
+  void await_resume() const {}
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  void Reset() {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace internal {
+
+// Eagerly started coroutine which destroys itself when done.
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() const noexcept { return {}; }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+}  // namespace internal
+
+/// Starts |task| on the current thread and lets it run to completion on its
+/// own, e.g. from a regular PostTask callback.
+inline void Detach(Task<> task) {
+  [](Task<> task) -> internal::DetachedTask { co_await std::move(task); }(
+      std::move(task));
+}
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::AwaitCallback;
+using lynx::fml::Detach;
+using lynx::fml::ResumeOn;
+using lynx::fml::Schedule;
+using lynx::fml::Task;
+}  // namespace fml
+
+#endif  // BASE_FML_HAS_COROUTINES
+
+#endif  // BASE_INCLUDE_FML_TASK_RUNNER_AWAITABLE_H_
@@ -44,6 +44,16 @@ inline ThreadStrategyForRendering ToAsyncEngineStrategy(
   return strategy;
 }
 
+inline ThreadStrategyForRendering ToSyncEngineStrategy(
+    base::ThreadStrategyForRendering strategy) {
+  if (strategy == MOST_ON_TASM) {
+    return ALL_ON_UI;
+  } else if (strategy == MULTI_THREADS) {
+    return PART_ON_LAYOUT;
+  }
+  return strategy;
+}
+
 class UIThread {
  public:
   BASE_EXPORT_FOR_DEVTOOL static fml::RefPtr<fml::TaskRunner>& GetRunner(
@@ -0,0 +1,200 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef BASE_INCLUDE_FML_THREAD_PLACEMENT_H_
+#define BASE_INCLUDE_FML_THREAD_PLACEMENT_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#endif
+
+#include "base/include/closure.h"
+#include "base/include/fml/cpu_affinity.h"
+
+namespace lynx {
+namespace fml {
+
+/// The threads of a Lynx instance, grouped by how latency sensitive they are.
+enum class ThreadRole : size_t {
+  /// Template rendering, on the critical path of every frame.
+  kTASM,
+  /// Layout, on the critical path of every frame.
+  kLayout,
+  /// The JS runtime thread.
+  kJS,
+  /// Workers of the high priority ConcurrentMessageLoop, e.g. parallel flush.
+  kHighPriorityWorker,
+  /// Workers of the normal priority ConcurrentMessageLoop and other off frame
+  /// work such as JsCacheManager code cache generation, CSS lazy decode and
+  /// ParallelParseTaskScheduler.
+  kBackground,
+};
+
+/// @brief Pins the current thread to the given CPU indices.
+///
+///        Returns true if successful, or if it was a no-op because |cpus| is
+///        empty or the platform has no affinity API, see
+///        RequestQualityOfService() for iOS.
+inline bool SetCurrentThreadAffinity(const std::vector<size_t>& cpus) {
+#if defined(__linux__)
+  if (cpus.empty()) {
+    return true;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  // 0 selects the calling thread.
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  return true;
+#endif
+}
+
+/// @brief Steers the current thread towards |affinity| through its QoS class,
+///        on Apple platforms which have no affinity API: the scheduler places
+///        USER_INTERACTIVE threads on the performance cores and UTILITY ones
+///        on the efficiency cores.
+///
+///        Returns true if successful, or if it was a no-op on other
+///        platforms. Fails if the thread has an explicit scheduling policy,
+///        e.g. one set with pthread_setschedparam().
+inline bool RequestQualityOfService(CpuAffinity affinity) {
+#if defined(__APPLE__)
+  qos_class_t qos_class = QOS_CLASS_USER_INITIATED;
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      qos_class = QOS_CLASS_USER_INTERACTIVE;
+      break;
+    case CpuAffinity::kNotEfficiency:
+      qos_class = QOS_CLASS_USER_INITIATED;
+      break;
+    case CpuAffinity::kEfficiency:
+    case CpuAffinity::kNotPerformance:
+      qos_class = QOS_CLASS_UTILITY;
+      break;
+  }
+  return pthread_set_qos_class_self_np(qos_class, 0) == 0;
+#else
+  (void)affinity;
+  return true;
+#endif
+}
+
+/**
+ * Decides which cores each ThreadRole should run on. The default policy keeps
+ * the frame critical TASM and layout threads on the performance cores and
+ * pushes background work to the efficiency cores, leaving the UI thread to the
+ * platform.
+ *
+ * A policy is applied by the thread itself when it starts, through the
+ * additional setup closure of its fml::Thread::ThreadConfig:
+ *
+ *   fml::Thread::ThreadConfig config(
+ *       "Lynx_TASM", fml::Thread::ThreadPriority::HIGH,
+ *       policy.CreateSetupClosure(fml::ThreadRole::kTASM));
+ *
+ * On Android the role is mapped to the CPU indices of RequestAffinity(), and
+ * requests are dropped when the cores cannot be told apart by speed. On iOS
+ * and macOS, where threads can not be pinned, it is mapped to a QoS class by
+ * RequestQualityOfService(). Either way it is only a hint to the scheduler.
+ */
+class ThreadPlacementPolicy {
+ public:
+  static constexpr size_t kRoleCount =
+      static_cast<size_t>(ThreadRole::kBackground) + 1;
+
+  /// A policy which leaves every thread where the OS puts it.
+  ThreadPlacementPolicy() = default;
+
+  static ThreadPlacementPolicy Default() {
+    ThreadPlacementPolicy policy;
+    policy.Set(ThreadRole::kTASM, CpuAffinity::kPerformance);
+    policy.Set(ThreadRole::kLayout, CpuAffinity::kPerformance);
+    policy.Set(ThreadRole::kJS, CpuAffinity::kNotEfficiency);
+    policy.Set(ThreadRole::kHighPriorityWorker, CpuAffinity::kNotEfficiency);
+    policy.Set(ThreadRole::kBackground, CpuAffinity::kEfficiency);
+    return policy;
+  }
+
+  void Set(ThreadRole role, std::optional<CpuAffinity> affinity) {
+    affinities_[static_cast<size_t>(role)] = affinity;
+  }
+
+  std::optional<CpuAffinity> Get(ThreadRole role) const {
+    return affinities_[static_cast<size_t>(role)];
+  }
+
+  bool IsEmpty() const {
+    for (const auto& affinity : affinities_) {
+      if (affinity) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Overrides the CPU speeds read from the system, visible for testing.
+  void SetCPUSpeedTracker(std::shared_ptr<const CPUSpeedTracker> tracker) {
+    tracker_ = std::move(tracker);
+  }
+
+  /// Applies the affinity of |role| to the current thread. Returns true if
+  /// successful or if there is nothing to apply.
+  bool Apply(ThreadRole role) const {
+    const std::optional<CpuAffinity> affinity = Get(role);
+    if (!affinity) {
+      return true;
+    }
+    if (tracker_ == nullptr) {
+#if defined(__APPLE__)
+      return RequestQualityOfService(*affinity);
+#else
+      return RequestAffinity(*affinity);
+#endif
+    }
+    if (!tracker_->IsValid()) {
+      return true;
+    }
+    return SetCurrentThreadAffinity(tracker_->GetIndices(*affinity));
+  }
+
+  /// Returns a closure applying |role| for ThreadConfig, or nullptr if the
+  /// policy leaves |role| alone.
+  std::shared_ptr<base::closure> CreateSetupClosure(ThreadRole role) const {
+    if (!Get(role)) {
+      return nullptr;
+    }
+    return std::make_shared<base::closure>(
+        [policy = *this, role]() { policy.Apply(role); });
+  }
+
+ private:
+  std::array<std::optional<CpuAffinity>, kRoleCount> affinities_{};
+  std::shared_ptr<const CPUSpeedTracker> tracker_;
+};
+
+}  // namespace fml
+}  // namespace lynx
+
+namespace fml {
+using lynx::fml::ThreadPlacementPolicy;
+using lynx::fml::ThreadRole;
+}  // namespace fml
+
+#endif  // BASE_INCLUDE_FML_THREAD_PLACEMENT_H_
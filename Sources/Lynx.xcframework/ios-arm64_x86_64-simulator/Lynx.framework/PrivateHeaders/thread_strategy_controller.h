@@ -0,0 +1,134 @@
+// Copyright 2025 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef CORE_SHELL_THREAD_STRATEGY_CONTROLLER_H_
+#define CORE_SHELL_THREAD_STRATEGY_CONTROLLER_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "base/include/closure.h"
+#include "base/include/fml/time/time_delta.h"
+#include "core/base/threading/task_runner_manufactor.h"
+
+namespace lynx {
+namespace shell {
+
+struct ThreadStrategyControllerConfig {
+  // A pipeline whose UI thread cost, see ThreadStrategyController, exceeds
+  // this on average is moved off the UI thread.
+  fml::TimeDelta async_threshold = fml::TimeDelta::FromMilliseconds(8);
+  // A pipeline whose UI thread cost stays below this on average comes back to
+  // the UI thread. Must be below async_threshold, the gap is the hysteresis.
+  fml::TimeDelta sync_threshold = fml::TimeDelta::FromMilliseconds(3);
+  // Consecutive pipelines beyond a threshold needed to switch.
+  uint32_t samples_to_switch = 3;
+  // Pipelines to wait after a switch before the next one, so that the cost of
+  // the switch itself does not trigger the way back. Also applies to the first
+  // pipelines, which are dominated by the initial load.
+  uint32_t cooldown_pipelines = 10;
+  // Weight of the newest sample in the moving average, in (0, 1].
+  double smoothing = 0.3;
+};
+
+/**
+ * Chooses between the sync (ALL_ON_UI, PART_ON_LAYOUT) and async
+ * (MOST_ON_TASM, MULTI_THREADS) flavour of a thread strategy from the
+ * measured cost of each pipeline, so that small pages skip the cross thread
+ * hand-off and heavy pages get the parallelism.
+ *
+ * Feed it the per pipeline TASM, layout and UI durations reported by
+ * TimingHandler. The cost it averages is the time the pipeline takes, or
+ * would take, on the UI thread in the sync flavour: the sum of the TASM and
+ * UI durations, plus the layout duration for ALL_ON_UI / MOST_ON_TASM. Stage
+ * durations do not depend on the thread a stage runs on, so the same cost is
+ * measured in both flavours. In the async ones the stages overlap, and their
+ * sum is what moving back would add to the UI thread, not the frame latency.
+ *
+ * When it decides to switch, |on_switch| is called with the new strategy and
+ * is expected to apply it, i.e. DynamicUIOperationQueue::Transfer together
+ * with EngineThreadSwitch::AttachEngineToUIThread or
+ * DetachEngineFromUIThread. It is opt-in: only shells which create one are
+ * affected.
+ *
+ * Not thread safe, samples must be reported on a single thread.
+ */
+class ThreadStrategyController {
+ public:
+  using SwitchCallback =
+      base::MoveOnlyClosure<void, base::ThreadStrategyForRendering>;
+
+  ThreadStrategyController(base::ThreadStrategyForRendering strategy,
+                           SwitchCallback on_switch,
+                           ThreadStrategyControllerConfig config = {})
+      : strategy_(strategy),
+        on_switch_(std::move(on_switch)),
+        config_(config),
+        cooldown_(config.cooldown_pipelines) {}
+
+  ThreadStrategyController(const ThreadStrategyController&) = delete;
+  ThreadStrategyController& operator=(const ThreadStrategyController&) =
+      delete;
+
+  base::ThreadStrategyForRendering GetStrategy() const { return strategy_; }
+
+  double GetAverageCostMicros() const { return average_micros_; }
+
+  // Returns true if the strategy was switched.
+  bool OnPipelineTiming(fml::TimeDelta tasm_duration,
+                        fml::TimeDelta layout_duration,
+                        fml::TimeDelta ui_duration) {
+    fml::TimeDelta ui_thread_cost = tasm_duration + ui_duration;
+    if (base::ToSyncEngineStrategy(strategy_) == base::ALL_ON_UI) {
+      ui_thread_cost = ui_thread_cost + layout_duration;
+    }
+    const double cost = ui_thread_cost.ToMicrosecondsF();
+    if (has_sample_) {
+      average_micros_ += config_.smoothing * (cost - average_micros_);
+    } else {
+      average_micros_ = cost;
+      has_sample_ = true;
+    }
+    if (cooldown_ > 0) {
+      --cooldown_;
+      return false;
+    }
+
+    const bool is_async = base::IsEngineAsync(strategy_);
+    const double async_threshold = config_.async_threshold.ToMicrosecondsF();
+    const double sync_threshold = config_.sync_threshold.ToMicrosecondsF();
+    const bool wants_async = !is_async && average_micros_ > async_threshold;
+    const bool wants_sync = is_async && average_micros_ < sync_threshold;
+    if (!wants_async && !wants_sync) {
+      streak_ = 0;
+      return false;
+    }
+    if (++streak_ < config_.samples_to_switch) {
+      return false;
+    }
+
+    strategy_ = wants_async ? base::ToAsyncEngineStrategy(strategy_)
+                            : base::ToSyncEngineStrategy(strategy_);
+    streak_ = 0;
+    cooldown_ = config_.cooldown_pipelines;
+    if (on_switch_) {
+      on_switch_(strategy_);
+    }
+    return true;
+  }
+
+ private:
+  base::ThreadStrategyForRendering strategy_;
+  SwitchCallback on_switch_;
+  ThreadStrategyControllerConfig config_;
+  double average_micros_{0};
+  bool has_sample_{false};
+  uint32_t streak_{0};
+  uint32_t cooldown_;
+};
+
+}  // namespace shell
+}  // namespace lynx
+
+#endif  // CORE_SHELL_THREAD_STRATEGY_CONTROLLER_H_
@@ -15,6 +15,8 @@
 #include <type_traits>
 #include <utility>
 
+#include "base/include/vector_search.h"
+
 #ifdef DEBUG
 #define BASE_VECTOR_DCHECK(...) assert(__VA_ARGS__)
 #else
@@ -1849,10 +1851,17 @@ struct BinarySearchArray : public KeyValueArray<K, T, N, Stat> {
 
  protected:
   BASE_VECTOR_NEVER_INLINE iterator lower_bound(const K& key) const {
-    return const_cast<iterator>(std::lower_bound(
-        begin(), end(), key, [](const value_type& item, const K& value) {
-          return Compare()(*reinterpret_cast<const K*>(&item), value);
-        }));
+    auto less = [](const value_type& item, const K& value) {
+      return Compare()(*reinterpret_cast<const K*>(&item), value);
+    };
+    if constexpr (vector_search::kIsVectorizableKey<K>) {
+      // Comparisons of integral keys are cheap enough that mispredicted
+      // branches dominate, use the branchless search.
+      return const_cast<iterator>(
+          vector_search::LowerBound(begin(), array_.size(), key, less));
+    } else {
+      return const_cast<iterator>(std::lower_bound(begin(), end(), key, less));
+    }
   }
 };
 
@@ -2069,12 +2078,23 @@ struct LinearSearchArray : public KeyValueArray<K, T, N, Stat> {
 
  protected:
   BASE_VECTOR_NEVER_INLINE iterator find_exact(const K& key) const {
-    for (auto it = array_.begin(), end = array_.end(); it != end; it++) {
-      if (*reinterpret_cast<const K*>(it) == key) {
-        return reinterpret_cast<iterator>(const_cast<store_iterator>(it));
+    if constexpr (vector_search::kIsVectorizableKey<K>) {
+      // Keys are contiguous for sets and interleaved with values for maps.
+      const auto* first = array_.begin();
+      const size_t count = array_.size();
+      const size_t index = vector_search::FindKey(
+          reinterpret_cast<const char*>(first), sizeof(*first), count, key);
+      return index < count ? reinterpret_cast<iterator>(
+                                 const_cast<store_iterator>(first + index))
+                           : nullptr;
+    } else {
+      for (auto it = array_.begin(), end = array_.end(); it != end; it++) {
+        if (*reinterpret_cast<const K*>(it) == key) {
+          return reinterpret_cast<iterator>(const_cast<store_iterator>(it));
+        }
       }
+      return nullptr;
     }
-    return nullptr;
   }
 };
 